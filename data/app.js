@@ -104,7 +104,31 @@ function userFun(buffer) {
     }
     return true;
   }
-  
+  else if (buffer[0] == 3) { //delta: only changed pixels, applied on the last full frame
+    let canvasNode = gId("Fixture.preview");
+    if (canvasNode && previewVar.file) {
+      let headerBytesPreview = 5
+      let bytesPerPixel = buffer[4]
+      if (cumulatativeBuffer.length >= headerBytesPreview + previewVar.file.nrOfLeds * bytesPerPixel && cumulatativeBuffer[4] == bytesPerPixel) {
+        cumulatativeBuffer[1] = buffer[1]; //rotations
+        cumulatativeBuffer[2] = buffer[2];
+        cumulatativeBuffer[3] = buffer[3];
+        let len = buffer[5] * 256 + buffer[6]; //used bytes of this package
+        let i = 7;
+        //runs of changed pixels: index (2 bytes), count (1 byte), count pixels
+        while (i + 3 <= len) {
+          let indexP = buffer[i] * 256 + buffer[i+1];
+          let count = buffer[i+2];
+          i += 3;
+          cumulatativeBuffer.set(buffer.subarray(i, i + count * bytesPerPixel), headerBytesPreview + indexP * bytesPerPixel);
+          i += count * bytesPerPixel;
+        }
+        preview3D(canvasNode, cumulatativeBuffer, previewVar);
+      }
+    }
+    return true;
+  }
+
   return false;
 }
 
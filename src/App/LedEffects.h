@@ -3152,6 +3152,10 @@ class RipplesEffect: public Effect {
     float ripple_interval = 1.3f * ((255.0f - interval)/128.0f) * sqrtf(leds.size.y);
     float time_interval = sys->now/(100.0 - speed)/((256.0f-128.0f)/20.0f);
 
+    //sin(d/ripple_interval + time_interval) as binary angle: per pixel one multiplication and sinQ15
+    const uint16_t timeAngle = fmodf(time_interval, M_TWOPI) * ANGLE_PER_RADIAN;
+    const float anglePerDistance = ripple_interval > 0?ANGLE_PER_RADIAN / ripple_interval:0;
+
     leds.fill_solid(CRGB::Black);
 
     Coord3D pos = {0,0,0};
@@ -3159,7 +3163,8 @@ class RipplesEffect: public Effect {
       for (pos.x=0; pos.x<leds.size.x; pos.x++) {
 
         float d = distance(leds.size.x/2.0f, leds.size.z/2.0f, 0.0f, (float)pos.x, (float)pos.z, 0.0f) / 9.899495f * leds.size.y;
-        pos.y = floor(leds.size.y/2.0f * (1 + sinf(d/ripple_interval + time_interval))); //between 0 and leds.size.y
+        uint16_t angle = timeAngle + (int32_t)(d * anglePerDistance);
+        pos.y = leds.size.y * (32767 + sinQ15(angle)) / 65534; //between 0 and leds.size.y
 
         leds[pos] = CHSV( sys->now/50 + random8(64), 200, 255);// ColorFromPalette(leds.palette,call, bri);
       }
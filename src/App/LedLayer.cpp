@@ -37,6 +37,27 @@ void fastled_fill_rainbow(struct CRGB * targetArray, int numToFill, uint8_t init
   fill_rainbow(targetArray, numToFill, initialhue, deltahue);
 }
 
+//round(32767 * sin(i * π / 512)): a quarter wave in 256 steps, + 1 for the interpolation of the last step
+const int16_t sinQ15Table[257] = {
+  0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210, 2410, 2611, 2811, 3012,
+  3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+  6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767, 7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+  9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+  12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+  15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+  18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+  20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856, 22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+  23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+  25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+  27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+  28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+  30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+  31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+  32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+  32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+  32767
+};
+
 void Effect::setup(LedsLayer &leds, Variable parentVar) {
     ui->initSelect(parentVar, "palette", 4, false, [&leds](EventArguments) { switch (eventType) {
       case onUI: {
@@ -75,7 +96,7 @@ void Effect::setup(LedsLayer &leds, Variable parentVar) {
 }
 
 void PhysMap::addIndexP(LedsLayer &leds, uint16_t indexP) {
-  // ppf("addIndexP i:%d t:%d", indexP, mapType);
+  ppfV(lc_mapping, "addIndexP i:%d t:%d\n", indexP, mapType);
   switch (mapType) {
     case m_color:
     // case m_rgbColor:
@@ -98,10 +119,9 @@ void PhysMap::addIndexP(LedsLayer &leds, uint16_t indexP) {
       break; }
     case m_morePixels:
       leds.mappingTableIndexes[indexes].push_back(indexP);
-      // ppf(" more %d", mappingTableIndexes.size());
+      ppfV(lc_mapping, "addIndexP more %d\n", leds.mappingTableIndexes[indexes].size());
       break;
   }
-  // ppf("\n");
 }
 
 void LedsLayer::triggerMapping() {
@@ -134,17 +154,71 @@ int LedsLayer::XYZ(int x, int y, int z) {
   // return XYZUnprojected(x, y, z);
 }
 
+#define XYZTABLE_EMPTY UINT16_MAX //not calculated yet for the current transform
+#define XYZTABLE_OUTSIDE (UINT16_MAX - 1) //projected outside the mappingTable
+#define XYZTABLE_MAX 16384 //entries (32 KB), larger (mostly sparse 3D) layers are not cached
+
 int LedsLayer::XYZ(Coord3D pixel) {
 
   //using cached virtual class methods! (so no need for if projectionNr optimizations!)
   if (projection) {
+    //reuse the projected result of this frame if already calculated (effects often touch the same pixel more then once per frame)
+    uint16_t *cached = (XYZTableUsed && inBounds(pixel))?&XYZTable[XYZUnprojected(pixel)]:nullptr;
+    if (cached && *cached != XYZTABLE_EMPTY)
+      return (*cached == XYZTABLE_OUTSIDE)?-1:*cached;
+
     projectionData.begin(); //not const
     (projection->*XYZCached)(*this, pixel); //not const
+
+    //projected outside the mappingTable is -1, cached or not (else setPixelColor / getPixelColor would treat it as an unmapped ledsP index)
+    int indexV = XYZUnprojected(pixel);
+    if (indexV >= mappingTableSizeUsed) indexV = -1;
+    if (cached) *cached = (indexV < 0)?XYZTABLE_OUTSIDE:indexV;
+    return indexV;
   }
 
   return XYZUnprojected(pixel);
 }
 
+void LedsLayer::XYZFrame() {
+  XYZTableUsed = false;
+  if (!projection) return;
+
+  projectionData.begin();
+  XYZCache xyzCache = (projection->*XYZFrameCached)(*this);
+
+  if (xyzCache != xyz_none) {
+    size_t tableSize = size.x * size.y * size.z;
+    if (XYZTable.size() != tableSize) {
+      XYZTable.clear(); XYZTable.shrink_to_fit(); //release the old table before checking the heap
+      //the table covers the bounding box: only cache if it is bounded and leaves enough heap for the rest
+      if (tableSize > XYZTABLE_MAX || tableSize * sizeof(uint16_t) > ESP.getMaxAllocHeap() / 2)
+        return;
+      xyzCache = xyz_changed;
+    }
+    if (xyzCache == xyz_changed)
+      XYZTable.assign(tableSize, XYZTABLE_EMPTY);
+    XYZTableUsed = true;
+  }
+}
+
+//the physical pixel as this layer sees it: its own buffer if shared with another active layer, else ledsP
+static inline CRGB &layerPixel(LedsLayer &leds, uint16_t indexP) {
+  if (leds.blendOverlap) {
+    const uint16_t slot = fix->sharedSlots[indexP];
+    if (slot != UINT16_MAX) return leds.layerLeds[slot];
+  }
+  return fix->ledsP[indexP];
+}
+
+static inline const CRGB &layerPixel(const LedsLayer &leds, uint16_t indexP) {
+  if (leds.blendOverlap) {
+    const uint16_t slot = fix->sharedSlots[indexP];
+    if (slot != UINT16_MAX) return leds.layerLeds[slot];
+  }
+  return fix->ledsP[indexP];
+}
+
 // maps the virtual led to the physical led(s) and assign a color to it
 void LedsLayer::setPixelColor(const int indexV, const CRGB& color) {
   if (indexV < 0)
@@ -166,26 +240,30 @@ void LedsLayer::setPixelColor(const int indexV, const CRGB& color) {
         //   fix->ledsP[indexP].b = color.r;
         // }
         // else
-        fix->ledsP[indexP] = fix->pixelsToBlend[indexP]?blend(color, fix->ledsP[indexP], fix->globalBlend):color;
+        layerPixel(*this, indexP) = color;
         break; }
-      case m_morePixels:
-        if (mappingTable[indexV].indexes < mappingTableIndexes.size())
-          for (uint16_t indexP: mappingTableIndexes[mappingTable[indexV].indexes]) {
-            // if (indexP > 2800) {
-            //   fix->ledsP[indexP].r = color.b;
-            //   fix->ledsP[indexP].g = color.g;
-            //   fix->ledsP[indexP].b = color.r;
+      case m_morePixels: {
+        const uint16_t indexes = mappingTable[indexV].indexes;
+        if (indexes + 1U < mappingTableIndexesStart.size()) {
+          const uint16_t *indexP = mappingTableIndexesFlat.data() + mappingTableIndexesStart[indexes];
+          const uint16_t *indexPEnd = mappingTableIndexesFlat.data() + mappingTableIndexesStart[indexes + 1];
+          for (; indexP < indexPEnd; indexP++) {
+            // if (*indexP > 2800) {
+            //   fix->ledsP[*indexP].r = color.b;
+            //   fix->ledsP[*indexP].g = color.g;
+            //   fix->ledsP[*indexP].b = color.r;
             // } else
-            fix->ledsP[indexP] = fix->pixelsToBlend[indexP]?blend(color, fix->ledsP[indexP], fix->globalBlend): color;
+            layerPixel(*this, *indexP) = color;
           }
+        }
         else
-          ppf("dev setPixelColor i:%d m:%d s:%d\n", indexV, mappingTable[indexV].indexes, mappingTableIndexes.size());
-        break;
+          ppfE(lc_effects, "dev setPixelColor i:%d m:%d s:%d\n", indexV, indexes, mappingTableIndexesStart.size());
+        break; }
       default: ;
     }
   }
-  else if (indexV < STARLIGHT_MAXLEDS) //no projection
-    fix->ledsP[indexV] = fix->pixelsToBlend[indexV]?blend(color, fix->ledsP[indexV], fix->globalBlend): color;
+  else if (indexV < fix->ledsPSize) //no projection
+    layerPixel(*this, indexV) = color;
   // some operations will go out of bounds e.g. VUMeter, uncomment below lines if you wanna test on a specific effect
   // else //if (indexV != UINT16_MAX) //assuming UINT16_MAX is set explicitly (e.g. in XYZ)
   //   ppf(" dev sPC %d >= %d", indexV, STARLIGHT_MAXLEDS);
@@ -205,10 +283,13 @@ CRGB LedsLayer::getPixelColor(const int indexV) const {
   else if (indexV < mappingTableSizeUsed) {
     switch (mappingTable[indexV].mapType) {
       case m_onePixel:
-        return fix->ledsP[mappingTable[indexV].indexP]; 
+        return layerPixel(*this, mappingTable[indexV].indexP);
         break;
       case m_morePixels:
-        return fix->ledsP[mappingTableIndexes[mappingTable[indexV].indexes][0]]; //any will do as they are all the same
+        if (mappingTable[indexV].indexes + 1U < mappingTableIndexesStart.size())
+          return layerPixel(*this, mappingTableIndexesFlat[mappingTableIndexesStart[mappingTable[indexV].indexes]]); //any will do as they are all the same
+        else
+          return CRGB::Black;
         break;
       default: // m_color:
         return CRGB((mappingTable[indexV].rgb14 >> 9) << 3, 
@@ -217,8 +298,8 @@ CRGB LedsLayer::getPixelColor(const int indexV) const {
         break;
     }
   }
-  else if (indexV < STARLIGHT_MAXLEDS) //no mapping
-    return fix->ledsP[indexV];
+  else if (indexV < fix->ledsPSize) //no mapping
+    return layerPixel(*this, indexV);
   else {
     // some operations will go out of bounds e.g. VUMeter, uncomment below lines if you wanna test on a specific effect
     // ppf(" dev gPC %d >= %d", indexV, STARLIGHT_MAXLEDS);
@@ -226,22 +307,160 @@ CRGB LedsLayer::getPixelColor(const int indexV) const {
   }
 }
 
+//the indexV's of the layer: the mapping table, or all leds if projection none (blending layers do not take the fastled paths)
+static inline int nrOfIndexesV(const LedsLayer &leds) {
+  return leds.projection?leds.mappingTableSizeUsed:min(fix->nrOfLeds, fix->ledsPSize);
+}
+
+//the physical pixel of indexV if m_onePixel or no mapping, UINT16_MAX for m_color, m_morePixels and out of bounds: use get/setPixelColor
+static inline uint16_t onePixel(const LedsLayer &leds, int indexV) {
+  if (indexV >= 0) {
+    if (indexV < leds.mappingTableSizeUsed) {
+      if (leds.mappingTable[indexV].mapType == m_onePixel)
+        return leds.mappingTable[indexV].indexP;
+    }
+    else if (indexV < fix->ledsPSize) //no mapping
+      return indexV;
+  }
+  return UINT16_MAX;
+}
+
+//resolve the mapping of one pixel of the span: XYZ is done by the caller
+static inline void spanAdd(LedsLayer &leds, int indexV) {
+  leds.spanIndexV.push_back(indexV);
+  leds.spanIndexP.push_back(onePixel(leds, indexV));
+}
+
+uint16_t LedsLayer::spanRow(int y, int z, uint16_t width) {
+  if (!projection) return spanRange(XYZUnprojected(0, y, z), width); //identity: indexV is consecutive
+  spanIndexV.clear();
+  spanIndexP.clear();
+  for (int x = 0; x < width; x++)
+    spanAdd(*this, XYZ(x, y, z));
+  return width;
+}
+
+uint16_t LedsLayer::spanColumn(int x, int z, uint16_t height) {
+  spanIndexV.clear();
+  spanIndexP.clear();
+  for (int y = 0; y < height; y++)
+    spanAdd(*this, projection?XYZ(x, y, z):XYZUnprojected(x, y, z));
+  return height;
+}
+
+uint16_t LedsLayer::spanRange(int indexV, uint16_t length) {
+  spanIndexV.clear();
+  spanIndexP.clear();
+  for (int i = 0; i < length; i++)
+    spanAdd(*this, indexV + i);
+  return length;
+}
+
+CRGB *LedsLayer::readSpan() {
+  spanPixels.resize(spanIndexV.size());
+  for (size_t i = 0; i < spanIndexV.size(); i++)
+    spanPixels[i] = (spanIndexP[i] != UINT16_MAX)?layerPixel(*this, spanIndexP[i]):getPixelColor(spanIndexV[i]);
+  return spanPixels.data();
+}
+
+void LedsLayer::writeSpan() {
+  for (size_t i = 0; i < spanPixels.size() && i < spanIndexV.size(); i++) {
+    if (spanIndexP[i] != UINT16_MAX)
+      layerPixel(*this, spanIndexP[i]) = spanPixels[i];
+    else
+      setPixelColor(spanIndexV[i], spanPixels[i]);
+  }
+}
+
+//FastLED blur1d
+void LedsLayer::blurSpan(fract8 blur_amount) {
+  const uint8_t keep = 255 - blur_amount;
+  const uint8_t seep = blur_amount >> 1;
+  CRGB carryover = CRGB::Black;
+  for (size_t i = 0; i < spanPixels.size(); i++) {
+    CRGB &cur = spanPixels[i];
+    CRGB part = cur;
+    part.nscale8(seep);
+    cur.nscale8(keep);
+    cur += carryover;
+    if (i) spanPixels[i-1] += part;
+    carryover = part;
+  }
+}
+
+void LedsLayer::moveRange(int indexV, int length, int distance) {
+  //only pixels of which source and destination are in the layer
+  const int first = max(indexV, -distance);
+  const int last = min(indexV + length, nrOfIndexesV(*this) - distance) - 1;
+
+  auto movePixel = [this, distance](int from) {
+    const uint16_t fromP = onePixel(*this, from);
+    const uint16_t toP = onePixel(*this, from + distance);
+    if (fromP != UINT16_MAX && toP != UINT16_MAX)
+      layerPixel(*this, toP) = layerPixel(*this, fromP);
+    else
+      setPixelColor(from + distance, getPixelColor(from));
+  };
+
+  //overlapping ranges: like memmove, start at the end when moving towards the end
+  if (distance > 0)
+    for (int from = last; from >= first; from--) movePixel(from);
+  else
+    for (int from = first; from <= last; from++) movePixel(from);
+}
+
+//one loop per blend mode: no switch per pixel
+template <typename BlendOp>
+static inline void blendLoop(CRGB *dst, const uint16_t *dstIndexes, const CRGB *src, const uint16_t *slots, size_t count, BlendOp blendOp) {
+  for (size_t i = 0; i < count; i++) {
+    CRGB &d = dst[dstIndexes[slots[i]]];
+    const CRGB &s = src[slots[i]];
+    d.r = blendOp(d.r, s.r);
+    d.g = blendOp(d.g, s.g);
+    d.b = blendOp(d.b, s.b);
+  }
+}
+
+void blendPixels(CRGB *dst, const uint16_t *dstIndexes, const CRGB *src, const uint16_t *slots, size_t count, uint8_t blendMode, uint8_t amount) {
+  switch (blendMode) {
+    case bm_add:
+      blendLoop(dst, dstIndexes, src, slots, count, [](uint8_t d, uint8_t s) {return qadd8(d, s);});
+      break;
+    case bm_lighten:
+      blendLoop(dst, dstIndexes, src, slots, count, [](uint8_t d, uint8_t s) {return max(d, s);});
+      break;
+    case bm_multiply:
+      blendLoop(dst, dstIndexes, src, slots, count, [](uint8_t d, uint8_t s) {return scale8(d, s);});
+      break;
+    case bm_screen:
+      blendLoop(dst, dstIndexes, src, slots, count, [](uint8_t d, uint8_t s) {return (uint8_t)(255 - scale8(255 - d, 255 - s));});
+      break;
+    case bm_subtract:
+      blendLoop(dst, dstIndexes, src, slots, count, [](uint8_t d, uint8_t s) {return qsub8(d, s);});
+      break;
+    default: //bm_normal, as blend(color, ledsP, globalBlend) before layers had their own buffers
+      blendLoop(dst, dstIndexes, src, slots, count, [amount](uint8_t d, uint8_t s) {return blend8(s, d, amount);});
+  }
+}
+
 void LedsLayer::fadeToBlackBy(const uint8_t fadeBy) {
   if (effectDimension < projectionDimension) { //only process the effect pixels (so projections can do things with the other dimension)
     for (int y=0; y < ((effectDimension == _1D)?1:size.y); y++) { //1D effects only on y=0, 2D effects loop over y
-      for (int x=0; x<size.x; x++) {
-        CRGB color = getPixelColor({x,y,0});
-        color.nscale8(255-fadeBy);
-        setPixelColor({x,y,0}, color);
-      }
+      spanRow(y, 0, size.x);
+      readSpan();
+      for (CRGB &color: spanPixels) color.nscale8(255-fadeBy);
+      writeSpan();
     }
-  } else if (!projection || (fix->layers.size() == 1)) { //faster, else manual 
-    fastled_fadeToBlackBy(fix->ledsP, fix->nrOfLeds, fadeBy);
+  } else if (!blendOverlap && (!projection || fix->layers.size() == 1)) { //faster, else manual 
+    fastled_fadeToBlackBy(fix->ledsP, min(fix->nrOfLeds, fix->ledsPSize), fadeBy);
   } else {
-    for (uint16_t index = 0; index < mappingTableSizeUsed; index++) {
-      CRGB color = getPixelColor(index);
-      color.nscale8(255-fadeBy);
-      setPixelColor(index, color);
+    const int spanLength = max(size.x, 1); //a row at a time to keep spanPixels small
+    const int nrOfIndexes = nrOfIndexesV(*this);
+    for (int index = 0; index < nrOfIndexes; index += spanLength) {
+      spanRange(index, min(spanLength, nrOfIndexes - index));
+      readSpan();
+      for (CRGB &color: spanPixels) color.nscale8(255-fadeBy);
+      writeSpan();
     }
   }
 }
@@ -249,15 +468,18 @@ void LedsLayer::fadeToBlackBy(const uint8_t fadeBy) {
 void LedsLayer::fill_solid(const CRGB& color) {
   if (effectDimension < projectionDimension) { //only process the effect pixels (so projections can do things with the other dimension)
     for (int y=0; y < ((effectDimension == _1D)?1:size.y); y++) { //1D effects only on y=0, 2D effects loop over y
-      for (int x=0; x<size.x; x++) {
-        setPixelColor({x,y,0}, color);
-      }
+      spanPixels.assign(spanRow(y, 0, size.x), color);
+      writeSpan();
     }
-  } else if (!projection || (fix->layers.size() == 1)) { //faster, else manual 
-    fastled_fill_solid(fix->ledsP, fix->nrOfLeds, color);
+  } else if (!blendOverlap && (!projection || fix->layers.size() == 1)) { //faster, else manual 
+    fastled_fill_solid(fix->ledsP, min(fix->nrOfLeds, fix->ledsPSize), color);
   } else {
-    for (uint16_t index = 0; index < mappingTableSizeUsed; index++)
-      setPixelColor(index, color);
+    const int spanLength = max(size.x, 1);
+    const int nrOfIndexes = nrOfIndexesV(*this);
+    for (int index = 0; index < nrOfIndexes; index += spanLength) {
+      spanPixels.assign(spanRange(index, min(spanLength, nrOfIndexes - index)), color);
+      writeSpan();
+    }
   }
 }
 
@@ -268,20 +490,23 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
     hsv.val = 255;
     hsv.sat = 240;
     for (int y=0; y < ((effectDimension == _1D)?1:size.y); y++) { //1D effects only on y=0, 2D effects loop over y
-      for (int x=0; x<size.x; x++) {
-        setPixelColor({x,y,0}, hsv);
+      spanPixels.resize(spanRow(y, 0, size.x));
+      for (CRGB &color: spanPixels) {
+        color = hsv;
         hsv.hue += deltahue;
       }
+      writeSpan();
     }
-  } else if (!projection || (fix->layers.size() == 1)) { //faster, else manual 
-    fastled_fill_rainbow(fix->ledsP, fix->nrOfLeds, initialhue, deltahue);
+  } else if (!blendOverlap && (!projection || fix->layers.size() == 1)) { //faster, else manual 
+    fastled_fill_rainbow(fix->ledsP, min(fix->nrOfLeds, fix->ledsPSize), initialhue, deltahue);
   } else {
     CHSV hsv;
     hsv.hue = initialhue;
     hsv.val = 255;
     hsv.sat = 240;
 
-    for (uint16_t index = 0; index < mappingTableSizeUsed; index++) {
+    const int nrOfIndexes = nrOfIndexesV(*this);
+    for (int index = 0; index < nrOfIndexes; index++) {
       setPixelColor(index, hsv);
       hsv.hue += deltahue;
     }
@@ -331,13 +556,15 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
     if (doMap) {
       fill_solid(CRGB::Black);
 
-      ppf("addPixelsPre clear leds[x] effect:%s pro:%s\n", effect?effect->name():"None", projection?projection->name():"None");
+      ppfI(lc_mapping, "addPixelsPre clear leds[x] effect:%s pro:%s\n", effect?effect->name():"None", projection?projection->name():"None");
       size = Coord3D{0,0,0};
-      //vectors really gone now?
-      for (std::vector<uint16_t> mappingTableIndex: mappingTableIndexes) {
-        mappingTableIndex.clear();
-      }
-      mappingTableIndexesSizeUsed = 0; //do not clear mappingTableIndexes, reuse it
+      mappingTableIndexesSizeUsed = 0; //mappingTableIndexes is released after compression in addPixelsPost, rebuilt while mapping
+      //compressed mapping is rebuilt in addPixelsPost
+      mappingTableIndexesFlat.clear();
+      mappingTableIndexesStart.clear();
+      //size and projection can change, XYZFrame creates a new table
+      XYZTable.clear();
+      XYZTableUsed = false;
 
       for (size_t i = 0; i < mappingTable.size(); i++) {
         mappingTable[i] = PhysMap();
@@ -373,7 +600,7 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
 
   void LedsLayer::addPixel(Coord3D pixel, const uint8_t rowNr) {
     if (projection && doMap) { //only real projections: add pixel in leds mappingTable
-      // ppf("addPixel %d %d", pixel, fix->factor);
+      ppfV(lc_mapping, "addPixel %d,%d,%d f:%d\n", pixel.x, pixel.y, pixel.z, fix->ledFactor);
       if (pixel >= start * fix->ledFactor && pixel <= end * fix->ledFactor ) { //if pixel between start and end pos
 
         pixel = pixel / fix->ledFactor - start; //pixel relative to start (also rounded to a 1x1 grid space in case of factor 10)
@@ -385,15 +612,15 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
         mdl->getValueRowNr = UINT8_MAX; // end of run projection functions in the right rowNr context
 
         if (pixel.x != UINT16_MAX) { //can be set to UINT16_MAX by projection
-          uint16_t indexV = XYZUnprojected(pixel);
+          int indexV = XYZUnprojected(pixel);
 
-          if (indexV >= size.x * size.y * size.z || indexV >= STARLIGHT_MAXLEDS)
-            ppf("dev addPixel leds[%d] indexV too high %d>=%d or %d (m:%d p:%d) p:%d,%d,%d s:%d,%d,%d\n", rowNr, indexV, size.x * size.y * size.z, STARLIGHT_MAXLEDS, mappingTableSizeUsed, fix->indexP, pixel.x, pixel.y, pixel.z, size.x, size.y, size.z);
+          if (indexV < 0 || indexV >= size.x * size.y * size.z || indexV >= STARLIGHT_MAXLEDS)
+            ppfE(lc_mapping, "dev addPixel leds[%d] indexV too high %d>=%d or %d (m:%d p:%d) p:%d,%d,%d s:%d,%d,%d\n", rowNr, indexV, size.x * size.y * size.z, STARLIGHT_MAXLEDS, mappingTableSizeUsed, fix->indexP, pixel.x, pixel.y, pixel.z, size.x, size.y, size.z);
           else {
             //create new physMaps if needed
-            if (indexV >= mappingTable.size()) {
-              for (size_t i = mappingTable.size(); i <= indexV; i++) {
-                // ppf("mapping %d,%d,%d add physMap before %d %d\n", pixel.y, pixel.y, pixel.z, indexV, mappingTable.size());
+            if ((size_t)indexV >= mappingTable.size()) {
+              for (size_t i = mappingTable.size(); i <= (size_t)indexV; i++) {
+                ppfV(lc_mapping, "mapping %d,%d,%d add physMap before %d %d\n", pixel.x, pixel.y, pixel.z, indexV, mappingTable.size());
                 mappingTable.push_back(PhysMap());
                 // mappingTableIndexesSizeUsed++;
               }
@@ -402,7 +629,7 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
             if (indexV >= mappingTableSizeUsed) mappingTableSizeUsed = indexV + 1;
 
             mappingTable[indexV].addIndexP(*this, fix->indexP);
-            // ppf("mapping b:%d t:%d V:%d\n", indexV, indexP, mappingTableSizeUsed);
+            ppfV(lc_mapping, "mapping b:%d t:%d V:%d\n", indexV, fix->indexP, mappingTableSizeUsed);
           } //indexV not too high
         } //pixel.x != UINT16_MAX
 
@@ -412,7 +639,7 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
 
   void LedsLayer::addPixelsPost(const uint8_t rowNr) {
     if (doMap) {
-      ppf("addPixelsPost leds[%d] effect:%s pro:%s\n", rowNr, effect?effect->name():"None", projection?projection->name():"None");
+      ppfI(lc_mapping, "addPixelsPost leds[%d] effect:%s pro:%s\n", rowNr, effect?effect->name():"None", projection?projection->name():"None");
 
       uint16_t nrOfLogical = 0;
       uint16_t nrOfPhysical = 0;
@@ -428,12 +655,30 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
       } else {
 
         if (mappingTable.size() < size.x * size.y * size.z)
-          ppf("addPixelsPost add extra physMap %d to %d size: %d,%d,%d\n", mappingTableSizeUsed, size.x * size.y * size.z, size.x, size.y, size.z);
+          ppfI(lc_mapping, "addPixelsPost add extra physMap %d to %d size: %d,%d,%d\n", mappingTableSizeUsed, size.x * size.y * size.z, size.x, size.y, size.z);
         for (size_t i = mappingTable.size(); i < size.x * size.y * size.z; i++) {
           mappingTable.push_back(PhysMap());
           mappingTableSizeUsed++;
         }
 
+        //compress mappingTableIndexes into one contiguous array: no heap block per virtual pixel and no pointer chasing in setPixelColor / getPixelColor
+        size_t nrOfIndexes = 0;
+        for (size_t i = 0; i < mappingTableIndexesSizeUsed; i++)
+          nrOfIndexes += mappingTableIndexes[i].size();
+        mappingTableIndexesFlat.reserve(nrOfIndexes);
+        mappingTableIndexesStart.reserve(mappingTableIndexesSizeUsed + 1);
+        for (size_t i = 0; i < mappingTableIndexesSizeUsed; i++) {
+          mappingTableIndexesStart.push_back(mappingTableIndexesFlat.size());
+          mappingTableIndexesFlat.insert(mappingTableIndexesFlat.end(), mappingTableIndexes[i].begin(), mappingTableIndexes[i].end());
+        }
+        mappingTableIndexesStart.push_back(mappingTableIndexesFlat.size());
+        mappingTableIndexesFlat.shrink_to_fit();
+        mappingTableIndexesStart.shrink_to_fit();
+
+        //release the vector of vectors used while mapping, all small allocations are freed at once
+        mappingTableIndexes.clear();
+        mappingTableIndexes.shrink_to_fit();
+
         //debug info + summary values
         for (size_t i = 0; i< mappingTableSizeUsed; i++) {
           PhysMap &map = mappingTable[i];
@@ -442,32 +687,25 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
               nrOfColor++;
               break;
             case m_onePixel:
-              // ppf("ledV %d mapping =1: #ledsP : %d\n", nrOfLogical, map.indexP);
+              ppfV(lc_mapping, "ledV %d mapping =1: #ledsP : %d\n", nrOfLogical, map.indexP);
               nrOfPhysical++;
               break;
             case m_morePixels:
-              // ppf("ledV %d mapping >1: #ledsP :", nrOfLogical);
-              
-              for (uint16_t indexP: mappingTableIndexes[map.indexes]) {
-                // ppf(" %d", indexP);
-                nrOfPhysicalM++;
-              }
-              // ppf("\n");
+              ppfV(lc_mapping, "ledV %d mapping >1: #ledsP : %d\n", nrOfLogical, mappingTableIndexesStart[map.indexes + 1] - mappingTableIndexesStart[map.indexes]);
+              nrOfPhysicalM += mappingTableIndexesStart[map.indexes + 1] - mappingTableIndexesStart[map.indexes];
               break;
           }
           nrOfLogical++;
-          // else
-          //   ppf("ledV %d no mapping\n", x);
         }
       }
 
-      ppf("addPixelsPost leds[%d] V:%d x %d x %d (v:%d - p:%d pm:%d of %d c:%d)\n", rowNr, size.x, size.y, size.z, nrOfLogical, nrOfPhysical, nrOfPhysicalM, mappingTableIndexesSizeUsed, nrOfColor);
+      ppfI(lc_mapping, "addPixelsPost leds[%d] V:%d x %d x %d (v:%d - p:%d pm:%d of %d c:%d)\n", rowNr, size.x, size.y, size.z, nrOfLogical, nrOfPhysical, nrOfPhysicalM, mappingTableIndexesSizeUsed, nrOfColor);
 
       StarString buf;
       buf.format("%d x %d x %d", size.x, size.y, size.z);
       mdl->setValue("layers", "size", JsonString(buf.getString()), rowNr);
 
-      ppf("addPixelsPost leds[%d].size = so:%d + m:(%d of %d) * %d + d:(%d + %d) B\n", rowNr, sizeof(LedsLayer), mappingTableSizeUsed, mappingTable.size(), sizeof(PhysMap), effectData.bytesAllocated, projectionData.bytesAllocated); //44 -> 164
+      ppfI(lc_mapping, "addPixelsPost leds[%d].size = so:%d + m:(%d of %d) * %d + i:(%d + %d) * %d + d:(%d + %d) B\n", rowNr, sizeof(LedsLayer), mappingTableSizeUsed, mappingTable.size(), sizeof(PhysMap), mappingTableIndexesFlat.size(), mappingTableIndexesStart.size(), sizeof(uint16_t), effectData.bytesAllocated, projectionData.bytesAllocated); //44 -> 164
 
       doMap = false;
     } //doMap
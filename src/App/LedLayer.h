@@ -23,6 +23,12 @@
 
 #include "../Sys/SysModModel.h" //for Coord3D
 
+#ifdef STARLIGHT_WIDE_INDEX
+  //PhysMap of 4 bytes with 16 bits indexes, ledsP is allocated for the fixture in mapInitAlloc (in PSRAM if found) so the board limit does not apply
+  #undef STARLIGHT_MAXLEDS
+  #define STARLIGHT_MAXLEDS 65534 //UINT16_MAX is used as no pixel
+#endif
+
 #ifndef STARLIGHT_MAXLEDS
   #define STARLIGHT_MAXLEDS 8192 //any board can do this
 #endif
@@ -47,6 +53,13 @@ public:
   virtual void loop(LedsLayer &leds) {}
 };
 
+//result of Projection::XYZFrame
+enum XYZCache {
+  xyz_none,      //XYZ is calculated on each call (default)
+  xyz_unchanged, //transform is the same as in the previous frame: reuse the results in leds.XYZTable
+  xyz_changed,   //transform changed: leds.XYZTable is reset and filled again on XYZ calls
+};
+
 class Projection {
 public:
   virtual ~Projection() = default;
@@ -67,6 +80,10 @@ public:
 
   //loopPixel
   virtual void XYZ(LedsLayer &leds, Coord3D &pixel) {}
+
+  //per frame, before the effect runs: projections with a time dependent XYZ update their transform here
+  //  if XYZ only depends on the pixel and on this state, return xyz_unchanged / xyz_changed so the results of XYZ are cached per frame
+  virtual XYZCache XYZFrame(LedsLayer &leds) {return xyz_none;}
 };
 
 enum mapType {
@@ -76,6 +93,38 @@ enum mapType {
   m_count //keep as last entry
 };
 
+//how a layer is composited on the active layers before it, only on the pixels they share (see LedModFixture::compositeLayers)
+enum BlendMode {
+  bm_normal,   //alpha: Blending slider
+  bm_add,
+  bm_lighten,  //max
+  bm_multiply,
+  bm_screen,
+  bm_subtract,
+  bm_count //keep as last entry
+};
+
+//dst[dstIndexes[slot]] = blendMode(dst[dstIndexes[slot]], src[slot]) for slot in slots, one loop per mode. amount is used by bm_normal
+void blendPixels(CRGB *dst, const uint16_t *dstIndexes, const CRGB *src, const uint16_t *slots, size_t count, uint8_t blendMode, uint8_t amount);
+
+#ifdef STARLIGHT_WIDE_INDEX
+struct PhysMap {
+  union {
+    uint16_t rgb14: 14;    //14 bits (554 RGB)
+    uint16_t indexP;       //65535 one physical pixel (type==1) index to ledsP array
+    uint16_t indexes;      //65535 multiple physical pixels (type==2) index in mappingTableIndexesStart (and in mappingTableIndexes during mapping)
+  }; // 2 bytes
+  byte mapType:2;          //2 bits (4) + padding: 4 bytes
+
+  PhysMap() {
+    mapType = m_color; // the default until indexP is added
+    rgb14 = 0;
+  }
+
+  void addIndexP(LedsLayer &leds, uint16_t indexP);
+
+}; // 4 bytes
+#else
 struct PhysMap {
   union {
     struct {                 //condensed rgb
@@ -83,7 +132,7 @@ struct PhysMap {
       byte mapType:2;        //2 bits (4)
     }; //16 bits
     uint16_t indexP: 14;   //16384 one physical pixel (type==1) index to ledsP array
-    uint16_t indexes:14;  //16384 multiple physical pixels (type==2) index in std::vector<std::vector<uint16_t>> mappingTableIndexes;
+    uint16_t indexes:14;  //16384 multiple physical pixels (type==2) index in mappingTableIndexesStart (and in mappingTableIndexes during mapping)
   }; // 2 bytes
 
   PhysMap() {
@@ -94,6 +143,42 @@ struct PhysMap {
   void addIndexP(LedsLayer &leds, uint16_t indexP);
 
 }; // 2 bytes
+#endif
+
+//cycles of one phase of the frame (effect, projection, composite, show) over the last nrOfSamples frames
+struct PhaseProfile {
+  static const uint8_t nrOfSamples = 32;
+  uint32_t samples[nrOfSamples];
+  uint8_t nrOfSamplesUsed = 0;
+  uint8_t sampleIndex = 0;
+
+  void add(uint32_t cycles) {
+    samples[sampleIndex] = cycles;
+    sampleIndex = (sampleIndex + 1) % nrOfSamples;
+    if (nrOfSamplesUsed < nrOfSamples) nrOfSamplesUsed++;
+  }
+
+  void clear() {
+    nrOfSamplesUsed = 0;
+    sampleIndex = 0;
+  }
+
+  //µs: min, avg, percentiles and max
+  void toText(char *text, size_t size, const char *label) const {
+    if (!nrOfSamplesUsed) {
+      snprintf(text, size, "%s -", label);
+      return;
+    }
+    uint32_t sorted[nrOfSamples];
+    memcpy(sorted, samples, nrOfSamplesUsed * sizeof(uint32_t));
+    std::sort(sorted, sorted + nrOfSamplesUsed);
+    uint64_t sum = 0;
+    for (uint8_t i = 0; i < nrOfSamplesUsed; i++) sum += sorted[i];
+    const uint32_t mhz = max(ESP.getCpuFreqMHz(), (uint32_t)1);
+    snprintf(text, size, "%s %lu<%lu p50 %lu p95 %lu<%lu", label, (unsigned long)(sorted[0] / mhz), (unsigned long)(sum / nrOfSamplesUsed / mhz), 
+                                                               (unsigned long)(sorted[nrOfSamplesUsed / 2] / mhz), (unsigned long)(sorted[nrOfSamplesUsed * 95 / 100] / mhz), (unsigned long)(sorted[nrOfSamplesUsed - 1] / mhz));
+  }
+};
 
 //StarLight implementation of segment.data
 class SharedData {
@@ -198,6 +283,7 @@ public:
   void (Projection::*addPixelCached)(LedsLayer &, Coord3D &) = &Projection::addPixel;
   void (Projection::*XYZCached)(LedsLayer &, Coord3D &) = &Projection::XYZ;
   void (Projection::*loopCached)(LedsLayer &) = &Projection::loop;
+  XYZCache (Projection::*XYZFrameCached)(LedsLayer &) = &Projection::XYZFrame;
 
   uint8_t effectDimension = UINT8_MAX;
   uint8_t projectionDimension = UINT8_MAX;
@@ -216,8 +302,28 @@ public:
 
   std::vector<PhysMap> mappingTable;
   uint16_t mappingTableSizeUsed = 0;
-  std::vector<std::vector<uint16_t>> mappingTableIndexes;
+  std::vector<std::vector<uint16_t>> mappingTableIndexes; //only used while mapping, compressed into mappingTableIndexesFlat in addPixelsPost
   uint16_t mappingTableIndexesSizeUsed = 0;
+  //compressed one-to-many mapping: the physical pixels of indexes i are mappingTableIndexesFlat[mappingTableIndexesStart[i] .. mappingTableIndexesStart[i+1]-1]
+  std::vector<uint16_t> mappingTableIndexesFlat; //all physical pixels of m_morePixels in one contiguous array
+  std::vector<uint16_t> mappingTableIndexesStart; //offset in mappingTableIndexesFlat per indexes, one extra entry at the end
+
+  uint8_t blendMode = bm_normal;
+
+  //cycles of effect->loop and projection loop, see LedModEffects layers table "time"
+  PhaseProfile effectProfile;
+  PhaseProfile projectionProfile;
+
+  //pixels shared with another active layer (LedModFixture::sharedSlots) are written to layerLeds instead of ledsP and composited after all layers ran
+  //  see LedModFixture::composeLayers and compositeLayers
+  std::vector<CRGB> layerLeds; //per slot of LedModFixture::sharedPixels, only the slots of this layer are used
+  std::vector<uint16_t> copyIndexes; //slots where this is the first active layer: copied to ledsP
+  std::vector<uint16_t> blendIndexes; //slots of an active layer before: blended on ledsP with blendMode
+  bool blendOverlap = false;
+
+  //per frame cache of projected XYZ results (indexV per unprojected pixel), see Projection::XYZFrame
+  std::vector<uint16_t> XYZTable;
+  bool XYZTableUsed = false;
   
   bool doMap = true; //so a mapping will be made
 
@@ -241,6 +347,9 @@ public:
   int XYZ(int x, int y, int z); // function not const as it calls projection which changes things
   int XYZ(Coord3D pixel); //pixel not const as pixel can be changed by projection, not & is it can change the pixel locally for projections ... (because called with {x,y,z} ..._
 
+  //per frame, before the effect runs: let the projection update its transform and (re)set the XYZTable
+  void XYZFrame();
+
   LedsLayer() {
     ppf("LedsLayer constructor (PhysMap:%d)\n", sizeof(PhysMap));
   }
@@ -249,11 +358,11 @@ public:
     ppf("LedsLayer destructor\n");
     fadeToBlackBy();
     doMap = true; // so loop is not running while deleting
-    for (std::vector<uint16_t> mappingTableIndex: mappingTableIndexes) {
-      mappingTableIndex.clear();
-    }
     mappingTableIndexes.clear();
+    mappingTableIndexesFlat.clear();
+    mappingTableIndexesStart.clear();
     mappingTable.clear();
+    XYZTable.clear();
   }
 
   void triggerMapping();
@@ -357,21 +466,29 @@ public:
     return indexV < mappingTableSizeUsed && (mappingTable[indexV].mapType == m_onePixel || mappingTable[indexV].mapType == m_morePixels);
   }
 
+  //spans: a row, column or range of pixels is resolved once (XYZ and mappingTable), read into spanPixels, processed and written back
+  //  spanRow(y, 0, size.x); CRGB *pixels = readSpan(); ... ; writeSpan();
+  std::vector<int> spanIndexV; //per pixel of the span
+  std::vector<uint16_t> spanIndexP; //m_onePixel or no mapping: the physical pixel, UINT16_MAX: use get/setPixelColor(indexV)
+  std::vector<CRGB> spanPixels;
+
+  uint16_t spanRow(int y, int z, uint16_t width);
+  uint16_t spanColumn(int x, int z, uint16_t height);
+  uint16_t spanRange(int indexV, uint16_t length); //indexV .. indexV + length - 1 (no XYZ)
+  CRGB *readSpan();
+  void writeSpan();
+  void blurSpan(fract8 blur_amount); //blur1d on spanPixels
+
+  //moves the pixels indexV .. indexV + length - 1 by distance pixels (no XYZ), overlap allowed, the pixels moved from keep their color
+  //  a row of a plane is size.x pixels, a plane size.x * size.y: moveRange(0, size.x * size.y * (size.z - 1), size.x * size.y) shifts all planes one step along z
+  void moveRange(int indexV, int length, int distance);
+
   void blur1d(fract8 blur_amount)
   {
-    const uint8_t keep = 255 - blur_amount;
-    const uint8_t seep = blur_amount >> 1;
-    CRGB carryover = CRGB::Black;
-    for( uint16_t i = 0; i < size.x; ++i) {
-        CRGB cur = getPixelColor(i);
-        CRGB part = cur;
-        part.nscale8( seep);
-        cur.nscale8( keep);
-        cur += carryover;
-        if( i) addPixelColor(i-1, part);
-        setPixelColor(i, cur);
-        carryover = part;
-    }
+    spanRange(0, size.x);
+    readSpan();
+    blurSpan(blur_amount);
+    writeSpan();
   }
 
   void blur2d(fract8 blur_amount)
@@ -380,49 +497,25 @@ public:
       blurColumns(size.x, size.y, blur_amount);
   }
 
+  // blurRows: perform a blur1d on each row of a rectangular matrix
   void blurRows(uint16_t width, uint16_t height, fract8 blur_amount)
   {
-  /*    for (uint16_t row = 0; row < height; row++) {
-          CRGB* rowbase = leds + (row * width);
-          blur1d( rowbase, width, blur_amount);
-      }
-  */
-      // blur rows same as columns, for irregular matrix
-      uint8_t keep = 255 - blur_amount;
-      uint8_t seep = blur_amount >> 1;
       for (uint16_t row = 0; row < height; row++) {
-          CRGB carryover = CRGB::Black;
-          for (uint16_t i = 0; i < width; i++) {
-              CRGB cur = getPixelColor(i, row, 0);
-              CRGB part = cur;
-              part.nscale8( seep);
-              cur.nscale8( keep);
-              cur += carryover;
-              if( i) addPixelColor(i-1, row, 0, part);
-              setPixelColor(i, row, 0, cur);
-              carryover = part;
-          }
+          spanRow(row, 0, width);
+          readSpan();
+          blurSpan(blur_amount);
+          writeSpan();
       }
   }
 
   // blurColumns: perform a blur1d on each column of a rectangular matrix
   void blurColumns(uint16_t width, uint16_t height, fract8 blur_amount)
   {
-      // blur columns
-      uint8_t keep = 255 - blur_amount;
-      uint8_t seep = blur_amount >> 1;
       for (uint16_t col = 0; col < width; ++col) {
-          CRGB carryover = CRGB::Black;
-          for (uint16_t i = 0; i < height; ++i) {
-              CRGB cur = getPixelColor(col, i, 0);
-              CRGB part = cur;
-              part.nscale8( seep);
-              cur.nscale8( keep);
-              cur += carryover;
-              if( i) addPixelColor(col, i-1, 0, part);
-              setPixelColor(col, i, 0, cur);
-              carryover = part;
-          }
+          spanColumn(col, 0, height);
+          readSpan();
+          blurSpan(blur_amount);
+          writeSpan();
       }
   }
 
@@ -678,26 +771,93 @@ public:
 //128: 128, 1      0 -32645
 //192: 1, 127      -32645 0
 
+//fixed point trigonometry: an angle of 65536 is a full turn (binary angle, as FastLED sin16), Q15: 32767 is 1.0
+#define ANGLE_PER_RADIAN 10430.378f //65536 / 2π
+
+extern const int16_t sinQ15Table[257]; //first quarter of the sine, see LedLayer.cpp
+
+//sin in Q15: table of a quarter wave with linear interpolation, error <= 1 (3e-5)
+inline int16_t sinQ15(uint16_t angle) {
+  uint16_t quarter = angle & 0x3FFF;
+  if (angle & 0x4000) quarter = 0x4000 - quarter; //second and fourth quarter mirrored
+  const uint16_t index = quarter >> 6;
+  const uint8_t fraction = quarter & 63;
+  int32_t value = sinQ15Table[index];
+  if (fraction) value += ((sinQ15Table[index + 1] - value) * fraction + 32) >> 6;
+  return (angle & 0x8000)?-value:value;
+}
+
+inline int16_t cosQ15(uint16_t angle) {
+  return sinQ15(angle + 0x4000);
+}
+
+//binary angle of y, x (0: x axis, 16384: y axis), |x|, |y| < 65536, error <= 17 (0.1°), 0 for 0, 0
+//  atan(t) ≈ π/4 t + t (1 - t) (0.2447 + 0.0663 t) on the octant t = min / max
+inline uint16_t atan2Angle(int32_t y, int32_t x) {
+  const uint32_t ax = abs(x);
+  const uint32_t ay = abs(y);
+  if (ax == 0 && ay == 0) return 0;
+  const bool steep = ay > ax;
+  const uint32_t t = steep?(ax << 15) / ay:(ay << 15) / ax; //Q15
+  const uint32_t p = (t * (32768 - t)) >> 15;
+  uint16_t angle = (t >> 2) + ((p * (2552 + ((692 * t) >> 15)) + 16384) >> 15); //π/4 is 8192
+  if (steep) angle = 0x4000 - angle;
+  if (x < 0) angle = 0x8000 - angle;
+  if (y < 0) angle = -angle;
+  return angle;
+}
+
+//sqrt(x * x + y * y) rounded down (exact), |x|, |y| <= 32767
+inline uint16_t hypotInt(int32_t x, int32_t y) {
+  uint32_t n = (uint32_t)(x * x) + (uint32_t)(y * y);
+  uint32_t root = 0;
+  for (uint32_t bit = 1UL << 30; bit; bit >>= 2) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+      root >>= 1;
+  }
+  return root;
+}
+
 static unsigned trigoCached = 1;
 static unsigned trigoUnCached = 1;
 
+//STARLIGHT_TRIGO_Q15: sin and cos from sinQ15 and the results as integer multiplication (rounded instead of truncated)
 struct Trigo {
   virtual ~Trigo() = default;
 
   uint16_t period = 360; //default period 360
   Trigo(uint16_t period = 360) {this->period = period;}
-  float sinValue[3]; uint16_t sinAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of sinValue=sin(sinAngle) for tilt, pan and roll
-  float cosValue[3]; uint16_t cosAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of cosValue=cos(cosAngle) for tilt, pan and roll
-  virtual float sinBase(uint16_t angle) {return sinf(M_TWOPI * angle / period);}
-  virtual float cosBase(uint16_t angle) {return cosf(M_TWOPI * angle / period);}
-  int16_t sin(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
-    if (sinAngle[cache012] != angle) {sinAngle[cache012] = angle; sinValue[cache012] = sinBase(angle);trigoUnCached++;} else trigoCached++;
-    return factor * sinValue[cache012];
-  };
-  int16_t cos(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
-    if (cosAngle[cache012] != angle) {cosAngle[cache012] = angle; cosValue[cache012] = cosBase(angle);trigoUnCached++;} else trigoCached++;
-    return factor * cosValue[cache012];
-  };
+  #ifdef STARLIGHT_TRIGO_Q15
+    int16_t sinValue[3]; uint16_t sinAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of sinValue=sin(sinAngle) in Q15 for tilt, pan and roll
+    int16_t cosValue[3]; uint16_t cosAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of cosValue=cos(cosAngle) in Q15 for tilt, pan and roll
+    virtual int16_t sinBase(uint16_t angle) {return sinQ15((uint32_t)angle * 65536 / period);}
+    virtual int16_t cosBase(uint16_t angle) {return cosQ15((uint32_t)angle * 65536 / period);}
+    int16_t sin(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
+      if (sinAngle[cache012] != angle) {sinAngle[cache012] = angle; sinValue[cache012] = sinBase(angle);trigoUnCached++;} else trigoCached++;
+      return (factor * sinValue[cache012] + 16384) >> 15;
+    };
+    int16_t cos(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
+      if (cosAngle[cache012] != angle) {cosAngle[cache012] = angle; cosValue[cache012] = cosBase(angle);trigoUnCached++;} else trigoCached++;
+      return (factor * cosValue[cache012] + 16384) >> 15;
+    };
+  #else
+    float sinValue[3]; uint16_t sinAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of sinValue=sin(sinAngle) for tilt, pan and roll
+    float cosValue[3]; uint16_t cosAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of cosValue=cos(cosAngle) for tilt, pan and roll
+    virtual float sinBase(uint16_t angle) {return sinf(M_TWOPI * angle / period);}
+    virtual float cosBase(uint16_t angle) {return cosf(M_TWOPI * angle / period);}
+    int16_t sin(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
+      if (sinAngle[cache012] != angle) {sinAngle[cache012] = angle; sinValue[cache012] = sinBase(angle);trigoUnCached++;} else trigoCached++;
+      return factor * sinValue[cache012];
+    };
+    int16_t cos(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
+      if (cosAngle[cache012] != angle) {cosAngle[cache012] = angle; cosValue[cache012] = cosBase(angle);trigoUnCached++;} else trigoCached++;
+      return factor * cosValue[cache012];
+    };
+  #endif
   // https://msl.cs.uiuc.edu/planning/node102.html
   Coord3D pan(Coord3D in, Coord3D middle, uint16_t angle) {
     Coord3D inM = in - middle;
@@ -729,6 +889,20 @@ struct Trigo {
   }
 };
 
+#ifdef STARLIGHT_TRIGO_Q15
+struct Trigo8: Trigo { //FastLed sin8 and cos8
+  using Trigo::Trigo;
+  int16_t sinBase(uint16_t angle) override {return (sin8((uint32_t)angle * 256 / period) - 128) * 258;}
+  int16_t cosBase(uint16_t angle) override {return (cos8((uint32_t)angle * 256 / period) - 128) * 258;}
+};
+struct Trigo16: Trigo { //FastLed sin16 and cos16
+  using Trigo::Trigo;
+  int16_t sinBase(uint16_t angle) override {return toQ15(sin16((uint32_t)angle * 65536 / period));}
+  int16_t cosBase(uint16_t angle) override {return toQ15(cos16((uint32_t)angle * 65536 / period));}
+  //sin16 peaks at 32645: scale to 32767 as the float version (/ 32645.0f), rounded
+  static int16_t toQ15(int16_t value) {return (value * 32767 + (value < 0?-16322:16322)) / 32645;}
+};
+#else
 struct Trigo8: Trigo { //FastLed sin8 and cos8
   using Trigo::Trigo;
   float sinBase(uint16_t angle) override {return (sin8(256.0f * angle / period) - 128) / 127.0f;}
@@ -739,5 +913,6 @@ struct Trigo16: Trigo { //FastLed sin16 and cos16
   float sinBase(uint16_t angle) override {return sin16(65536.0f * angle / period) / 32645.0f;}
   float cosBase(uint16_t angle) override {return cos16(65536.0f * angle / period) / 32645.0f;}
 };
+#endif
 
 static Trigo trigoTiltPanRoll(255); // Trigo8 is hardly any faster (27 vs 28 fps) (spanXY=28)
\ No newline at end of file
@@ -11,6 +11,7 @@
 
 #include "LedModEffects.h"
 
+#include "SysModules.h"
 #include "../Sys/SysModUI.h"
 #include "../Sys/SysModFiles.h"
 #include "../Sys/SysModSystem.h"
@@ -201,6 +202,7 @@ inline uint16_t getRGBWsize(uint16_t nleds){
 
           if (effectNr < effects.size()) {
             leds->effect = effects[effectNr];
+            leds->effectProfile.clear();
             ppf("setEffect effect[%d]: %s\n", rowNr, leds->effect->name());
             strlcat(fix->tickerTape, leds->effect->name(), sizeof(fix->tickerTape));
 
@@ -256,6 +258,7 @@ inline uint16_t getRGBWsize(uint16_t nleds){
               leds->projection = nullptr; //not projections[0] so test on if (leds->projection) can be used
             else
               leds->projection = projections[proValue];
+            leds->projectionProfile.clear();
 
             ppf("initProjection leds[%d] projection:%s a:%d\n", rowNr, leds->projection?leds->projection->name():"None", leds->projectionData.bytesAllocated);
 
@@ -282,6 +285,30 @@ inline uint16_t getRGBWsize(uint16_t nleds){
     }});
     currentVar.var["dash"] = true;
 
+    ui->initSelect(tableVar, "blend", (uint8_t)bm_normal, false, [this](EventArguments) { switch (eventType) {
+      case onSetValue:
+        for (size_t rowNr = 0; rowNr < fix->layers.size(); rowNr++)
+          variable.setValue(fix->layers[rowNr]->blendMode, rowNr);
+        return true;
+      case onUI: {
+        variable.setComment("Where layers overlap, Normal uses Blending");
+        JsonArray options = variable.setOptions();
+        options.add("Normal"); //bm_normal
+        options.add("Add");
+        options.add("Lighten");
+        options.add("Multiply");
+        options.add("Screen");
+        options.add("Subtract");
+        return true; }
+      case onChange:
+        if (rowNr < fix->layers.size()) {
+          uint8_t blendMode = variable.getValue(rowNr);
+          fix->layers[rowNr]->blendMode = blendMode < bm_count?blendMode:bm_normal;
+        }
+        return true;
+      default: return false;
+    }});
+
     ui->initCoord3D(tableVar, "start", {0,0,0}, 0, STARLIGHT_MAXLEDS, false, [this](EventArguments) { switch (eventType) {
       case onSetValue:
         //is this needed?
@@ -378,6 +405,26 @@ inline uint16_t getRGBWsize(uint16_t nleds){
       default: return false;
     }});
 
+    ui->initText(tableVar, "time", nullptr, 64, true, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("µs effect (E) and projection (P): min<avg p50 p95<max of the last frames");
+        return true;
+      case onLoop1s: {
+        uint8_t rowNr = 0;
+        for (LedsLayer *leds:fix->layers) {
+          char effectText[48];
+          char projectionText[48];
+          char text[96];
+          leds->effectProfile.toText(effectText, sizeof(effectText), "E");
+          leds->projectionProfile.toText(projectionText, sizeof(projectionText), "P");
+          snprintf(text, sizeof(text), "%s %s", effectText, projectionText);
+          variable.setValue(JsonString(text), rowNr); //copied
+          rowNr++;
+        }
+        return true; }
+      default: return false;
+    }});
+
     // ui->initSelect(parentVar, "layout", 0, false, [](EventArguments) { switch (eventType) {
     //   case onUI: {
     //     variable.setComment("WIP");
@@ -424,16 +471,34 @@ inline uint16_t getRGBWsize(uint16_t nleds){
 
     random16_set_seed(sys->now);
 
-    //set new frame
-    if (sys->now - frameMillis >= 1000.0/fix->fps - 1 && fix->mappingStatus == 0) { //floorf to make it no wait to go beyond 1000 fps ;-)
-
-      //reset pixelsToBlend if multiple leds effects
-      // ppf(" %d-%d", fix->pixelsToBlend.size(), fix->nrOfLeds);
-      if (fix->layers.size() > 1) //if more then one effect
-        for (uint16_t indexP=0; indexP < fix->pixelsToBlend.size(); indexP++)
-          fix->pixelsToBlend[indexP] = false;
+    //set new frame at absolute deadlines, so the frame rate does not drift with the time other modules take
+    const unsigned long nowMicros = micros();
+    if (fix->mappingStatus != 0) { //start again after mapping, not counted as dropped frames
+      frameDeadline = 0;
+      mdls->deadlineMicros = 0;
+    }
 
-      frameMillis = sys->now;
+    if (fix->mappingStatus == 0 && (frameDeadline == 0 || (long)(nowMicros - frameDeadline) >= 0)) {
+
+      const unsigned long frameInterval = 1000000UL / max(fix->fps, (uint16_t)1);
+      if (frameDeadline == 0) frameDeadline = nowMicros;
+      const unsigned long lateness = nowMicros - frameDeadline;
+      const unsigned long latenessMs = lateness / 1000;
+      latenessHistogram[latenessMs?min(32 - __builtin_clz((uint32_t)latenessMs), latenessBuckets - 1):0]++;
+      if (lateness >= frameInterval) { //deadlines missed: count them and continue from now instead of catching up
+        droppedFrames += lateness / frameInterval;
+        droppedFramesTotal += lateness / frameInterval;
+        frameDeadline = nowMicros + frameInterval;
+      } else
+        frameDeadline += frameInterval;
+      mdls->deadlineMicros = frameYield?frameDeadline:0;
+
+      //blend masks for the layers running this frame, only made again if the mapping or the running layers changed
+      uint32_t activeLayers = 0;
+      for (uint8_t rowNr = 0; rowNr < fix->layers.size() && rowNr < 32; rowNr++)
+        if (fix->layers[rowNr]->effect && !fix->layers[rowNr]->doMap) activeLayers |= 1 << rowNr;
+      if (fix->doComposeLayers || activeLayers != fix->composedLayers)
+        fix->composeLayers(activeLayers);
 
       newFrame = true;
 
@@ -447,11 +512,16 @@ inline uint16_t getRGBWsize(uint16_t nleds){
           leds->effectData.begin(); //sets the effectData pointer back to 0 so loop effect can go through it
 
           mdl->getValueRowNr = rowNr;
+          uint32_t cycles = ESP.getCycleCount();
+          leds->XYZFrame(); //before the effect so all XYZ calls in this frame use the same transform
           leds->effect->loop(*leds);
+          leds->effectProfile.add(ESP.getCycleCount() - cycles);
           //using cached virtual class methods! (so no need for if projectionNr optimizations!)
           if (leds->projection) {
+            cycles = ESP.getCycleCount();
             leds->projectionData.begin();
             (leds->projection->*leds->loopCached)(*leds);
+            leds->projectionProfile.add(ESP.getCycleCount() - cycles);
           }
           mdl->getValueRowNr = UINT8_MAX;
 
@@ -474,20 +544,13 @@ inline uint16_t getRGBWsize(uint16_t nleds){
           // if (leds->projectionNr == p_TiltPanRoll || leds->projectionNr == p_Preset1)
           //   leds->fadeToBlackBy(50);
 
-          //loop over mapped pixels and set pixelsToBlend to true
-          if (fix->layers.size() > 1) { //if more then one effect
-            for (const std::vector<uint16_t>& mappingTableIndex: leds->mappingTableIndexes) {
-              for (const uint16_t indexP: mappingTableIndex)
-                fix->pixelsToBlend[indexP] = true;
-            }
-            for (const PhysMap &physMap: leds->mappingTable) {
-              if (physMap.mapType == m_onePixel)
-                fix->pixelsToBlend[physMap.indexP] = true;
-            }
-          }
         }
       }
 
+      uint32_t cycles = ESP.getCycleCount();
+      fix->compositeLayers(); //the pixels shared by layers, from their own buffers into ledsP
+      fix->compositeProfile.add(ESP.getCycleCount() - cycles);
+
       frameCounter++;
     }
     else {
@@ -19,6 +19,13 @@ public:
   bool newFrame = false; //for other modules (DDP)
   unsigned long frameCounter = 0;
 
+  //frame scheduler: frames are due at absolute deadlines, lateness is how long after its deadline a frame started
+  bool3State frameYield = false; //opt-in: periodic loops of modules wait if the next frame is near (SysModules::deadlineMicros)
+  static const uint8_t latenessBuckets = 6; //ms: 0, 1, 2-3, 4-7, 8-15, 16+
+  uint16_t latenessHistogram[latenessBuckets] = {}; //frames per bucket, reset each second by the Fixture "lateness" value
+  uint16_t droppedFrames = 0; //deadlines missed, reset each second
+  unsigned long droppedFramesTotal = 0;
+
   std::vector<Effect *> effects;
   std::vector<Projection *> projections;
 
@@ -36,7 +43,7 @@ public:
   // void loop10s() override;
 
 private:
-  unsigned long frameMillis = 0;
+  unsigned long frameDeadline = 0; //micros, 0: start again
   JsonObject varSystem = JsonObject(); //for use in loop
 
 };
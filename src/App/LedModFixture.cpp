@@ -11,6 +11,7 @@
 
 #include "LedModFixture.h"
 #include "LedModEffects.h"
+#include "SysModules.h"
 
 #include "../Sys/SysModUI.h"
 #include "../Sys/SysModFiles.h"
@@ -23,6 +24,20 @@
   #include "../User/UserModAudioSync.h"
 #endif
 
+#ifdef STARLIGHT_DOUBLE_BUFFER
+  //sends each frame handed over by LedModFixture::loop, on the other core then the loop task
+  static void showTask(void * parameter) {
+    for (;;) {
+      xSemaphoreTake(fix->frameReady, portMAX_DELAY);
+      uint32_t cycles = ESP.getCycleCount();
+      fix->driverShow();
+      fix->showProfile.add(ESP.getCycleCount() - cycles);
+      fix->showCounter++;
+      xSemaphoreGive(fix->showDone);
+    }
+  }
+#endif
+
 #define PACKAGE_SIZE 5120 //4096 is not ideal as also header info, multiples of 1024 sounds good...
 
 #ifdef STARBASE_USERMOD_LIVE
@@ -82,6 +97,13 @@
 
     const Variable parentVar = ui->initAppMod(Variable(), name, 1100);
 
+    //deleting a fixture in the files table also removes its mapping cache
+    files->onDeleteFile = [](const char * path) {
+      char cacheName[32];
+      if (fix->mappingCacheName(cacheName, path) && files->remove(cacheName))
+        ppf("onDeleteFile %s removed\n", cacheName);
+    };
+
     Variable currentVar = ui->initCheckBox(parentVar, "on", true, false, [](EventArguments) { switch (eventType) {
       case onChange:
         Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true); //set brightness (init is true so bri value not send via udp)
@@ -94,15 +116,11 @@
     currentVar = ui->initSlider(parentVar, "brightness", &bri, 0, 255, false, [this](EventArguments) { switch (eventType) {
       case onChange: {
         //bri set by StarMod during onChange
-        uint8_t result = mdl->getValue("Fixture", "on").as<bool>()?mdl->linearToLogarithm(bri):0;
+        outputBri = mdl->getValue("Fixture", "on").as<bool>()?mdl->linearToLogarithm(bri):0;
 
-        #if STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
-          driver.setBrightness(result * setMaxPowerBrightnessFactor / 256);
-        #else
-          FastLED.setBrightness(result);
-        #endif
+        makeOutputLut();
 
-        ppf("Set Brightness to %d -> b:%d r:%d\n", variable.value().as<int>(), bri, result);
+        ppf("Set Brightness to %d -> b:%d r:%d\n", variable.value().as<int>(), bri, outputBri);
         return true; }
       default: return false; 
     }});
@@ -118,88 +136,162 @@
         }
         return true;
       case onLoop: {
-        if (!web->isBusy && mappingStatus == 0 && bytesPerPixel && !doSendFixtureDefinition && web->ws.getClients().length()) { //not remapping and clients exists
-          variable.var["interval"] = max(nrOfLeds * web->ws.count()/200, 16U)*10; //interval in ms * 10, not too fast //from cs to ms
+        if (!web->isBusy && mappingStatus == 0 && nrOfLeds <= ledsPSize && bytesPerPixel && !doSendFixtureDefinition && web->ws.getClients().length()) { //not remapping, leds allocated and clients exists
+
+          //adapt the preview rate to the websocket queues: slower if clients do not keep up, faster if they do. Never wait for them
+          size_t queueLen = web->maxQueueLen();
+          if (queueLen > 2) {
+            previewInterval = min(previewInterval * 2, 2000);
+            variable.var["interval"] = previewInterval;
+            return true; //skip this frame
+          }
+          if (queueLen == 0)
+            previewInterval = max(previewInterval - previewInterval / 8, 20); //loop20ms
+          variable.var["interval"] = previewInterval;
+
+          //send all pixels if the clients may not have the previous frame, otherwise only the changed pixels
+          //client ids are not reused, so a client which replaced another one is also seen
+          size_t frameLen = nrOfLeds * bytesPerPixel;
+          uint32_t newestClientId = 0;
+          for (auto &client: web->ws.getClients()) newestClientId = max(newestClientId, (uint32_t)client->id());
+          bool keyFrame = previewResend || previewFrame.size() != frameLen || previewClientId != newestClientId;
+          previewFrame.resize(frameLen);
+          previewClientId = newestClientId;
+          previewResend = false;
 
           #define headerBytesPreview 5
-          // ppf("(%d %d %d,%d,%d)", len, headerBytesPreview + nrOfLeds * bytesPerPixel, fixSize.x, fixSize.y, fixSize.z);
-          size_t len = min(headerBytesPreview + nrOfLeds * bytesPerPixel, PACKAGE_SIZE);
-          AsyncWebSocketMessageBuffer *wsBuf= web->ws.makeBuffer(len); //global wsBuf causes crash in audio sync module!!!
-          if (wsBuf) {
+          #define headerBytesPreviewDelta 7 //+ 2 bytes used length as delta packages are not filled completely
+          byte header[headerBytesPreview];
+          header[0] = keyFrame?2:3; //userFun id
+          //rotations
+          if (viewRotation == 0) {
+            header[1] = 0;
+            header[2] = 0;
+            header[3] = 0;
+          } else if (viewRotation == 1) { //tilt
+            header[1] = beat8(1);//, 0, 255);
+            header[2] = 0;//beatsin8(4, 250, 5);
+            header[3] = 0;//beatsin8(6, 255, 5);
+          } else if (viewRotation == 2) { //pan
+            header[1] = 0;//beatsin8(4, 250, 5);
+            header[2] = beat8(1);//, 0, 255);
+            header[3] = 0;//beatsin8(6, 255, 5);
+          } else if (viewRotation == 3) { //roll
+            header[1] = 0;//beatsin8(4, 250, 5);
+            header[2] = 0;//beatsin8(6, 255, 5);
+            header[3] = beat8(1);//, 0, 255);
+          } else if (viewRotation == 4) {
+            header[1] = head.x;
+            header[2] = head.y;
+            header[3] = head.z;
+          }
+          header[4] = bytesPerPixel;
+
+          //each package gets its own buffer: a send buffer is queued, not copied
+          AsyncWebSocketMessageBuffer *wsBuf = nullptr; //global wsBuf causes crash in audio sync module!!!
+          byte* buffer = nullptr;
+          uint16_t previewBufferIndex = 0;
+          bool sent = true;
+
+          auto newBuffer = [&](size_t indexP) -> bool {
+            //key frame packages contain whole pixels only, as the ui appends them
+            size_t len = keyFrame?headerBytesPreview + min(nrOfLeds - indexP, (size_t)((PACKAGE_SIZE - headerBytesPreview) / bytesPerPixel)) * bytesPerPixel:PACKAGE_SIZE;
+            wsBuf = web->ws.makeBuffer(len);
+            if (!wsBuf) return false;
             wsBuf->lock();
-            byte* buffer = wsBuf->get();
-            //new values
-            buffer[0] = 2; //userFun id
-            //rotations
-            if (viewRotation == 0) {
-              buffer[1] = 0;
-              buffer[2] = 0;
-              buffer[3] = 0;
-            } else if (viewRotation == 1) { //tilt
-              buffer[1] = beat8(1);//, 0, 255);
-              buffer[2] = 0;//beatsin8(4, 250, 5);
-              buffer[3] = 0;//beatsin8(6, 255, 5);
-            } else if (viewRotation == 2) { //pan
-              buffer[1] = 0;//beatsin8(4, 250, 5);
-              buffer[2] = beat8(1);//, 0, 255);
-              buffer[3] = 0;//beatsin8(6, 255, 5);
-            } else if (viewRotation == 3) { //roll
-              buffer[1] = 0;//beatsin8(4, 250, 5);
-              buffer[2] = 0;//beatsin8(6, 255, 5);
-              buffer[3] = beat8(1);//, 0, 255);
-            } else if (viewRotation == 4) {
-              buffer[1] = head.x;
-              buffer[2] = head.y;
-              buffer[3] = head.z;
+            buffer = wsBuf->get();
+            memcpy(buffer, header, headerBytesPreview);
+            if (keyFrame && indexP) {
+              buffer[1] = UINT8_MAX; //indicates follow up package
+              buffer[2] = indexP/256;
+              buffer[3] = indexP%256;
             }
-            buffer[4] = bytesPerPixel;
-            uint16_t previewBufferIndex = headerBytesPreview;
-
-            // send leds preview to clients
-            for (size_t indexP = 0; indexP < nrOfLeds; indexP++) {
-
-              if (previewBufferIndex + bytesPerPixel > PACKAGE_SIZE) {
-                //send the buffer and create a new one
-                web->sendBuffer(wsBuf, true);
-                delay(10);
-                buffer[0] = 2; //userFun id
-                buffer[1] = UINT8_MAX; //indicates follow up package
-                buffer[2] = indexP/256; //fixSize.x%256;
-                buffer[3] = indexP%256; //fixSize.x%256;
-                buffer[4] = bytesPerPixel;
-                // ppf("@");
-                // ppf("new buffer created i:%d p:%d r:%d r6:%d\n", indexP, previewBufferIndex, (nrOfLeds - indexP), (nrOfLeds - indexP) * 6);
-                previewBufferIndex = headerBytesPreview;
-              }
+            previewBufferIndex = keyFrame?headerBytesPreview:headerBytesPreviewDelta;
+            return true;
+          };
+
+          auto sendBuffer = [&]() {
+            if (!keyFrame) {
+              buffer[5] = previewBufferIndex/256;
+              buffer[6] = previewBufferIndex%256;
+            }
+            sent &= web->sendBuffer(wsBuf, true);
+            wsBuf->unlock();
+            wsBuf = nullptr;
+          };
 
-              uint16_t indexP2 = indexP;
-              //causes too much flickering for some reason, so leave it for now
-              // #ifdef STARLIGHT_LIVE_MAPPING
-              //   indexP2 = mapLed(indexP);
-              // #endif
+          size_t runIndex = 0; //delta: buffer index of the count of the current run of changed pixels, 0 is no run
 
-              if (bytesPerPixel == 1) {
-                //encode rgb in 8 bits: 3 for red, 3 for green, 2 for blue (0xE0 = 01110000)
-                buffer[previewBufferIndex++] = (ledsP[indexP2].red & 0xE0) | ((ledsP[indexP2].green & 0xE0)>>3) | (ledsP[indexP2].blue >> 6);
-              }
-              else if (bytesPerPixel == 2) {
-                //encode rgb in 16 bits: 5 for red, 6 for green, 5 for blue
-                buffer[previewBufferIndex++] = (ledsP[indexP2].red & 0xF8) | (ledsP[indexP2].green >> 5); // Take 5 bits of Red component and 3 bits of G component
-                buffer[previewBufferIndex++] = ((ledsP[indexP2].green & 0x1C) << 3) | (ledsP[indexP2].blue  >> 3); // Take remaining 3 Bits of G component and 5 bits of Blue component
+          // send leds preview to clients
+          for (size_t indexP = 0; indexP < nrOfLeds; indexP++) {
+
+            if (!wsBuf && !newBuffer(indexP)) {
+              sent = false;
+              break;
+            }
+
+            uint16_t indexP2 = indexP;
+            //causes too much flickering for some reason, so leave it for now
+            // #ifdef STARLIGHT_LIVE_MAPPING
+            //   indexP2 = mapLed(indexP);
+            // #endif
+
+            byte pixel[3];
+            if (bytesPerPixel == 1) {
+              //encode rgb in 8 bits: 3 for red, 3 for green, 2 for blue (0xE0 = 01110000)
+              pixel[0] = (ledsP[indexP2].red & 0xE0) | ((ledsP[indexP2].green & 0xE0)>>3) | (ledsP[indexP2].blue >> 6);
+            }
+            else if (bytesPerPixel == 2) {
+              //encode rgb in 16 bits: 5 for red, 6 for green, 5 for blue
+              pixel[0] = (ledsP[indexP2].red & 0xF8) | (ledsP[indexP2].green >> 5); // Take 5 bits of Red component and 3 bits of G component
+              pixel[1] = ((ledsP[indexP2].green & 0x1C) << 3) | (ledsP[indexP2].blue  >> 3); // Take remaining 3 Bits of G component and 5 bits of Blue component
+            }
+            else {
+              pixel[0] = ledsP[indexP2].red;
+              pixel[1] = ledsP[indexP2].green;
+              pixel[2] = ledsP[indexP2].blue;
+            }
+
+            //previewFrame: what the clients have after this frame
+            byte *previous = &previewFrame[indexP * bytesPerPixel];
+            bool changed = memcmp(previous, pixel, bytesPerPixel) != 0;
+            if (changed) memcpy(previous, pixel, bytesPerPixel);
+
+            if (!keyFrame) {
+              if (!changed) {
+                runIndex = 0; //end of run
+                continue;
               }
-              else {
-                buffer[previewBufferIndex++] = ledsP[indexP2].red;
-                buffer[previewBufferIndex++] = ledsP[indexP2].green;
-                buffer[previewBufferIndex++] = ledsP[indexP2].blue;
+              //delta: runs of changed pixels: index (2 bytes), count (1 byte), count pixels. Each package can be applied on its own
+              if (!runIndex || buffer[runIndex] == UINT8_MAX || previewBufferIndex + bytesPerPixel > PACKAGE_SIZE) {
+                if (previewBufferIndex + 3 + bytesPerPixel > PACKAGE_SIZE) {
+                  sendBuffer();
+                  if (!newBuffer(indexP)) {
+                    sent = false;
+                    break;
+                  }
+                }
+                buffer[previewBufferIndex++] = indexP/256;
+                buffer[previewBufferIndex++] = indexP%256;
+                runIndex = previewBufferIndex;
+                buffer[previewBufferIndex++] = 0;
               }
-            } //loop
+              buffer[runIndex]++;
+            }
 
-            web->sendBuffer(wsBuf, true);
+            memcpy(&buffer[previewBufferIndex], pixel, bytesPerPixel);
+            previewBufferIndex += bytesPerPixel;
 
-            wsBuf->unlock();
-            web->ws._cleanBuffers();
-          }
+            if (keyFrame && previewBufferIndex == wsBuf->length())
+              sendBuffer(); //next pixel creates a new buffer
+          } //loop
 
+          if (wsBuf)
+            sendBuffer(); //a delta without changes is also send, for the rotation
+
+          web->ws._cleanBuffers();
+
+          previewResend = !sent; //if a package did not arrive, the next frame sends all pixels
         }
 
         return true;}
@@ -277,22 +369,23 @@
       default: return false;
     }});
 
-    #if STARLIGHT_PHYSICAL_DRIVER | STARLIGHT_VIRTUAL_DRIVER
-      ui->initSlider(parentVar, "gammaRed", &gammaRed, 0, 255, false, [this](EventArguments) { switch (eventType) {
+    #ifdef STARLIGHT_OUTPUT_GAMMA
+      //gamma per channel (value^(255/gamma)), applied by outputLut and the I2S drivers
+      ui->initSlider(parentVar, "gammaRed", &gammaRed, 0, 255, false, [](EventArguments) { switch (eventType) {
         case onChange:
-          driver.setGamma(gammaRed/255.0, gammaGreen/255.0, gammaBlue/255.0);
+          Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true); //makes outputLut (init is true so bri value not send via udp)
           return true;
         default: return false;
       }});
-      ui->initSlider(parentVar, "gammaGreen", &gammaGreen, 0, 255, false, [this](EventArguments) { switch (eventType) {
+      ui->initSlider(parentVar, "gammaGreen", &gammaGreen, 0, 255, false, [](EventArguments) { switch (eventType) {
         case onChange:
-          driver.setGamma(gammaRed/255.0, gammaGreen/255.0, gammaBlue/255.0);
+          Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true);
           return true;
         default: return false;
       }});
-      ui->initSlider(parentVar, "gammaBlue", &gammaBlue, 0, 255, false, [this](EventArguments) { switch (eventType) {
+      ui->initSlider(parentVar, "gammaBlue", &gammaBlue, 0, 255, false, [](EventArguments) { switch (eventType) {
         case onChange:
-          driver.setGamma(gammaRed/255.0, gammaGreen/255.0, gammaBlue/255.0);
+          Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true);
           return true;
         default: return false;
       }});
@@ -316,6 +409,38 @@
       default: return false;
     }});
 
+    currentVar = ui->initText(parentVar, "lateness", nullptr, 64, true);
+    currentVar.setComment("Frames per second by ms after their deadline, dropped frames (total)");
+    currentVar.subscribe(onLoop1s, [](EventArguments) {
+      variable.setValueF("0:%d 1:%d 2:%d 4:%d 8:%d 16+:%d dropped %d (%lu)", eff->latenessHistogram[0], eff->latenessHistogram[1], eff->latenessHistogram[2], 
+                                                                         eff->latenessHistogram[3], eff->latenessHistogram[4], eff->latenessHistogram[5], eff->droppedFrames, eff->droppedFramesTotal);
+      memset(eff->latenessHistogram, 0, sizeof(eff->latenessHistogram));
+      eff->droppedFrames = 0;
+    });
+
+    ui->initCheckBox(parentVar, "frameYield", &eff->frameYield, false, [](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("Periodic module work waits if the next frame is near (off by default)");
+        return true;
+      case onChange:
+        if (!eff->frameYield) mdls->deadlineMicros = 0;
+        return true;
+      default: return false;
+    }});
+
+    #ifdef STARLIGHT_DOUBLE_BUFFER
+      ui->initNumber(parentVar, "showFps", &showFps, 0, UINT16_MAX, true, [this](EventArguments) { switch (eventType) {
+        case onUI:
+          variable.setComment("Frames sent by the show task");
+          return true;
+        case onLoop1s:
+            variable.setValue(showCounter);
+            showCounter = 0;
+          return true;
+        default: return false;
+      }});
+    #endif
+
     ui->initCheckBox(parentVar, "tickerTape", &showTicker);
 
     ui->initCheckBox(parentVar, "showDriver", &showDriver, false, [this](EventArguments) { switch (eventType) {
@@ -341,29 +466,51 @@
     //   }});
     // #endif
 
-    #if STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
-      fix->setMaxPowerBrightnessFactor = 90; //0..255
-    #else
-      ui->initNumber(parentVar, "maxPower", &maxPowerWatt, 0, UINT8_MAX, false, [this](EventArguments) { switch (eventType) {
+    ui->initNumber(parentVar, "maxPower", &maxPowerWatt, 0, UINT8_MAX, false, [](EventArguments) { switch (eventType) {
       case onUI:
-        variable.setComment("in Watts");
+        variable.setComment("in Watts, 0: no limit");
         return true;
-        case onChange:
-          FastLED.setMaxPowerInMilliWatts(maxPowerWatt * 1000); // 5v, 2000mA
-          return true;
-        default: return false;
-      }});
-    #endif
+      default: return false;
+    }});
+
+    currentVar = ui->initText(parentVar, "time", nullptr, 64, true);
+    currentVar.setComment("µs composite (C) and show (S): min<avg p50 p95<max of the last frames");
+    currentVar.subscribe(onLoop1s, [this](EventArguments) {
+      char compositeText[48];
+      char showText[48];
+      compositeProfile.toText(compositeText, sizeof(compositeText), "C");
+      showProfile.toText(showText, sizeof(showText), "S");
+      variable.setValueF("%s %s", compositeText, showText);
+    });
+
+    currentVar = ui->initText(parentVar, "power", nullptr, 32, true);
+    currentVar.setComment("Estimate at 5V, % of brightness");
+    currentVar.subscribe(onLoop1s, [this](EventArguments) {
+      variable.setValueF("%.1f W %d%%", powerMilliAmps * 5 / 1000.0, powerBrightness * 100 / 255);
+    });
 
     addPresets(parentVar.var);
 
+    #ifdef STARLIGHT_DOUBLE_BUFFER
+      frameReady = xSemaphoreCreateBinary();
+      showDone = xSemaphoreCreateBinary();
+      xSemaphoreGive(showDone); //nothing to send yet
+      //loop task runs on core 1
+      xTaskCreatePinnedToCore(showTask, "LedsShow", 4096, nullptr, 1, nullptr, 0);
+    #endif
   }
 
   void LedModFixture::loop() {
     //use lastMappingMillis and not loop1s as doMap needs to start asap, not wait for next second
     if (mappingStatus == 1 && sys->now - lastMappingMillis >= 1000) { //not more then once per second (for E131)
       lastMappingMillis = sys->now;
+      #ifdef STARLIGHT_DOUBLE_BUFFER
+        xSemaphoreTake(showDone, portMAX_DELAY); //no remapping (driverInit) while the show task sends
+      #endif
       mapInitAlloc();
+      #ifdef STARLIGHT_DOUBLE_BUFFER
+        xSemaphoreGive(showDone);
+      #endif
     }
 
     #ifdef STARLIGHT_USERMOD_AUDIOSYNC
@@ -376,14 +523,109 @@
 
     #endif
 
-    if (showDriver && !web->isBusy && mappingStatus == 0) //mappingStatus: otherwise driverShow in virtual driver hangs
-      driverShow();
+    if (eff->newFrame && mappingStatus == 0) estimatePower(); //before the frame is send, so the limit applies to it
+
+    if (showDriver && !web->isBusy && mappingStatus == 0) { //mappingStatus: otherwise driverShow in virtual driver hangs
+      #ifdef STARLIGHT_DOUBLE_BUFFER
+        //hand over the last rendered frame if the previous one has been sent, otherwise a later frame will be handed over
+        if (eff->newFrame && xSemaphoreTake(showDone, 0) == pdTRUE) {
+          //the copy for the driver is also the output transform
+          const uint16_t nrOfPixels = min(nrOfLeds, ledsPSize);
+          for (uint16_t indexP = 0; indexP < nrOfPixels; indexP++) {
+            ledsDriver[indexP].r = outputLut[0][ledsP[indexP].r];
+            ledsDriver[indexP].g = outputLut[1][ledsP[indexP].g];
+            ledsDriver[indexP].b = outputLut[2][ledsP[indexP].b];
+          }
+          xSemaphoreGive(frameReady);
+        }
+      #else
+        uint32_t cycles = ESP.getCycleCount();
+        driverShow();
+        showProfile.add(ESP.getCycleCount() - cycles);
+      #endif
+    }
   }
 
   void LedModFixture::loop1s() {
     memmove(tickerTape, tickerTape+1, strlen(tickerTape)); //no memory leak ?
   }
 
+  //gamma as the drivers do (value^(1/(gamma/255))), then brightness. Brightness only if the leds get no gamma, so network outputs look the same
+  void LedModFixture::makeOutputLut() {
+    #ifdef STARLIGHT_OUTPUT_GAMMA
+      const uint8_t gammas[3] = {gammaRed, gammaGreen, gammaBlue};
+      for (int channel = 0; channel < 3; channel++) {
+        const float exponent = 255.0f / max(gammas[channel], (uint8_t)1);
+        for (int value = 0; value < 256; value++)
+          gammaLut[channel][value] = scale8((uint8_t)(powf(value / 255.0f, exponent) * 255.0f + 0.5f), outputBri);
+      }
+    #else
+      for (int channel = 0; channel < 3; channel++)
+        for (int value = 0; value < 256; value++)
+          gammaLut[channel][value] = scale8(value, outputBri); //as FastLED.setBrightness
+    #endif
+
+    //with double buffering outputLut is applied when the frame is handed over, so not again by the driver
+    #if STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
+      #ifdef STARLIGHT_DOUBLE_BUFFER
+        driver.setGamma(1.0, 1.0, 1.0);
+      #else
+        driver.setGamma(gammaRed/255.0, gammaGreen/255.0, gammaBlue/255.0);
+      #endif
+    #endif
+
+    setOutputBrightness();
+  }
+
+  void LedModFixture::setOutputBrightness() {
+    for (int channel = 0; channel < 3; channel++)
+      for (int value = 0; value < 256; value++)
+        outputLut[channel][value] = scale8(gammaLut[channel][value], powerBrightness);
+
+    #ifdef STARLIGHT_DOUBLE_BUFFER
+      const uint8_t driverBrightness = 255; //in outputLut
+    #else
+      const uint8_t driverBrightness = scale8(outputBri, powerBrightness);
+    #endif
+    #if STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
+      driver.setBrightness(driverBrightness);
+    #else
+      FastLED.setBrightness(driverBrightness);
+    #endif
+  }
+
+  //called each new frame: sums one phase of the pixels, so the whole of ledsP is covered every powerPhases frames
+  //gammaLut holds the values the active driver sends (with or without gamma, see STARLIGHT_OUTPUT_GAMMA), so the estimate is not lowered by a gamma the leds do not get
+  void LedModFixture::estimatePower() {
+    const uint16_t nrOfPixels = min(nrOfLeds, ledsPSize);
+    uint32_t sum = 0;
+    for (uint16_t indexP = powerPhase; indexP < nrOfPixels; indexP += powerPhases)
+      sum += gammaLut[0][ledsP[indexP].r] * powerRedMilliAmps + gammaLut[1][ledsP[indexP].g] * powerGreenMilliAmps + gammaLut[2][ledsP[indexP].b] * powerBlueMilliAmps;
+    powerPhaseSums[powerPhase] = sum;
+    powerPhase = (powerPhase + 1) % powerPhases;
+
+    uint32_t channelMilliAmps = 0;
+    for (const uint32_t phaseSum: powerPhaseSums)
+      channelMilliAmps += phaseSum;
+    channelMilliAmps /= 255;
+    const uint32_t darkMilliAmps = nrOfPixels * powerDarkMilliAmps;
+
+    //as FastLED calculate_max_brightness_for_power_mW: the dark current is scaled too, so large fixtures are not switched off
+    uint8_t newPowerBrightness = 255;
+    const uint32_t budgetMilliAmps = maxPowerWatt * 1000 / 5;
+    if (maxPowerWatt && channelMilliAmps + darkMilliAmps > budgetMilliAmps)
+      newPowerBrightness = budgetMilliAmps * 255 / (channelMilliAmps + darkMilliAmps);
+
+    //down at once, up by at most powerStep per frame so the brightness does not jump when the estimate drops
+    if (newPowerBrightness > powerBrightness + powerStep) newPowerBrightness = powerBrightness + powerStep;
+    if (newPowerBrightness != powerBrightness) {
+      powerBrightness = newPowerBrightness;
+      setOutputBrightness();
+    }
+
+    powerMilliAmps = (channelMilliAmps + darkMilliAmps) * powerBrightness / 255;
+  }
+
   void LedModFixture::mapInitAlloc() {
 
     mappingStatus = 2; //mapping in progress
@@ -395,7 +637,7 @@
     //   for (int j=0;j<256;j++)
     //     ledsP[j+i*256]=j < i + 1?CRGB::Red: CRGB::Black; //each panel get as much red pixels as its sequence in the chain
     // }
-    for (int i = 0; i < STARLIGHT_MAXLEDS; i++)
+    for (int i = 0; i < ledsPSize; i++)
       ledsP[i] = CRGB::Black;
 
     char fileName[32] = "";
@@ -458,9 +700,17 @@
       {
         start = millis();
 
-        //first pass: find fixSize and nrOfLeds
+        char cacheName[32];
+        mappingCacheName(cacheName, fileName);
+        MappingCacheHeader cacheHeader;
+        bool cacheKey = mappingCacheKey(fileName, cacheHeader);
+
+        //first pass: find fixSize and nrOfLeds (and record the mapping cache)
         //second pass: create mappings
-        for (pass = 1; pass <=2; pass++)
+        //skipped if the mapping cache is valid, it does both passes from the cache
+        if (cacheKey && mappingCacheReplay(cacheName, fileName, cacheHeader))
+          ppf("mapInitAlloc %s from %s %d ms\n", fileName, cacheName, millis() - start);
+        else for (pass = 1; pass <=2; pass++)
         {
           StarJson starJson(fileName); //open fileName for deserialize
 
@@ -471,11 +721,18 @@
             starJson.lookFor("factor", &ledFactor);
             starJson.lookFor("ledSize", &ledSize);
             starJson.lookFor("shape", &ledShape);
-            starJson.lookFor("pin", &currPin);
+
+            if (cacheKey) {
+              cacheHeader.fixtureHash = mappingCacheHash(fileName);
+              mappingCacheFile = files->open(cacheName, FILE_WRITE);
+              if (mappingCacheFile)
+                mappingCacheFile.write((uint8_t *)&cacheHeader, sizeof(cacheHeader));
+            }
           }
+          starJson.lookFor("pin", &currPin); //both passes, addPin is processed in pass 2
 
           //lookFor leds array and for each item in array call lambda to make a projection
-          starJson.lookFor("leds", [this, &first](std::vector<uint16_t> uint16CollectList) { //this will be called for each tuple of coordinates!
+          starJson.lookFor("leds", [this, &first](const std::vector<uint16_t> &uint16CollectList) { //this will be called for each tuple of coordinates!
 
             if (first) { 
               addPixelsPre();
@@ -496,7 +753,22 @@
             }
           }); //starJson.lookFor("leds" (create the right type, otherwise crash)
 
-          if (starJson.deserialize()) { //this will call above function parameter for each led
+          bool deserialized = starJson.deserialize(); //this will call above function parameter for each led
+
+          if (mappingCacheFile) {
+            if (deserialized) {
+              MappingCacheTrailer cacheTrailer;
+              cacheTrailer.ledFactor = ledFactor;
+              cacheTrailer.ledSize = ledSize;
+              cacheTrailer.ledShape = ledShape;
+              mappingCacheFile.write((uint8_t *)&cacheTrailer, sizeof(cacheTrailer));
+            }
+            mappingCacheFile.close();
+            if (!deserialized)
+              files->remove(cacheName);
+          }
+
+          if (deserialized) {
             addPixelsPost();
           } // if deserialize
         }
@@ -522,15 +794,259 @@
 
   } //mapInitAlloc
 
+  //fileName: /F_name.json, cacheName: /M_name.map (no F_ so not in the fixture list), false if fileName is not a fixture (F_) file
+  bool LedModFixture::mappingCacheName(char * cacheName, const char * fileName) {
+    const char * name = strnstr(fileName, "F_", 32);
+    bool isFixture = name != nullptr;
+    name = isFixture?name + 2:fileName + 1; //skip F_ or /
+    strlcpy(cacheName, "/M_", 32);
+    strlcat(cacheName, name, 32);
+    char * extension = strrchr(cacheName, '.');
+    if (extension) *extension = '\0';
+    strlcat(cacheName, ".map", 32);
+    return isFixture;
+  }
+
+  //size and last write of the fixture file, the hash is only made if these match the cache or a cache is written
+  bool LedModFixture::mappingCacheKey(const char * fileName, MappingCacheHeader &header) {
+    File f = files->open(fileName, FILE_READ);
+    if (!f) return false;
+
+    header.fixtureSize = f.size();
+    header.fixtureTime = f.getLastWrite();
+
+    f.close();
+    return true;
+  }
+
+  //reading the file is much faster then parsing it, so hash it to also catch changes with the same size and time
+  uint32_t LedModFixture::mappingCacheHash(const char * fileName) {
+    uint32_t hash = 2166136261; //FNV-1a
+    File f = files->open(fileName, FILE_READ);
+    if (!f) return hash;
+
+    uint8_t buffer[256];
+    size_t len;
+    while ((len = f.read(buffer, sizeof(buffer))) > 0) {
+      for (size_t i = 0; i < len; i++)
+        hash = (hash ^ buffer[i]) * 16777619;
+    }
+
+    f.close();
+    return hash;
+  }
+
+  //same calls as the json walk in mapInitAlloc, but from the recorded pixels and pins
+  bool LedModFixture::mappingCacheReplay(const char * cacheName, const char * fileName, const MappingCacheHeader &header) {
+    File f = files->open(cacheName, FILE_READ);
+    if (!f) return false;
+
+    MappingCacheHeader cacheHeader;
+    MappingCacheTrailer cacheTrailer;
+    size_t fileSize = f.size();
+
+    bool valid = fileSize >= sizeof(cacheHeader) + sizeof(cacheTrailer)
+              && f.read((uint8_t *)&cacheHeader, sizeof(cacheHeader)) == sizeof(cacheHeader)
+              && cacheHeader.sameFile(header)
+              && (fileSize - sizeof(cacheHeader) - sizeof(cacheTrailer)) % header.recordSize == 0
+              && f.seek(fileSize - sizeof(cacheTrailer))
+              && f.read((uint8_t *)&cacheTrailer, sizeof(cacheTrailer)) == sizeof(cacheTrailer)
+              && cacheTrailer.magic == MappingCacheTrailer().magic
+              && cacheHeader.fixtureHash == mappingCacheHash(fileName); //last: only read if all the rest matches
+
+    if (!valid) {
+      ppf("mappingCacheReplay %s outdated or incomplete\n", cacheName);
+      f.close();
+      return false;
+    }
+
+    ledFactor = cacheTrailer.ledFactor;
+    ledSize = cacheTrailer.ledSize;
+    ledShape = cacheTrailer.ledShape;
+
+    size_t nrOfRecords = (fileSize - sizeof(cacheHeader) - sizeof(cacheTrailer)) / header.recordSize;
+
+    for (pass = 1; pass <=2; pass++) {
+      f.seek(sizeof(cacheHeader));
+
+      addPixelsPre();
+
+      uint16_t records[32][3];
+      size_t recordNr = 0;
+      while (recordNr < nrOfRecords) {
+        size_t chunk = min(nrOfRecords - recordNr, (size_t)32);
+        if (f.read((uint8_t *)records, chunk * sizeof(records[0])) != chunk * sizeof(records[0])) {
+          ppf("mappingCacheReplay %s read error at %d\n", cacheName, recordNr);
+          break;
+        }
+        for (size_t i = 0; i < chunk; i++) {
+          if (records[i][0] == UINT16_MAX)
+            addPin(records[i][1]);
+          else
+            addPixel({records[i][0], records[i][1], records[i][2]});
+        }
+        recordNr += chunk;
+      }
+
+      addPixelsPost();
+    }
+
+    f.close();
+    return true;
+  }
+
+#ifdef STARLIGHT_WIDE_INDEX
+  //ledsP (and ledsDriver) for the leds of the fixture, in PSRAM if found
+  //only grows, a smaller fixture uses the first nrOfLeds: a driver may still send the previous buffer until driverInit
+  void LedModFixture::allocLeds() {
+    if (ledsP && nrOfLeds <= ledsPSize) return;
+
+    if (ledsDAdded) {
+      ppfE(lc_mapping, "allocLeds %d leds: the FastLED driver sends the %d leds allocated, restart to use this fixture\n", nrOfLeds, ledsPSize); //nrOfLeds > ledsPSize: pass 2 is skipped
+      return;
+    }
+
+    CRGB *newLedsP = (CRGB *)(psramFound()?ps_calloc(nrOfLeds, sizeof(CRGB)):calloc(nrOfLeds, sizeof(CRGB)));
+    #ifdef STARLIGHT_DOUBLE_BUFFER
+      CRGB *newLedsDriver = (CRGB *)(psramFound()?ps_calloc(nrOfLeds, sizeof(CRGB)):calloc(nrOfLeds, sizeof(CRGB)));
+      if (!newLedsDriver) {
+        free(newLedsP);
+        newLedsP = nullptr;
+      }
+    #endif
+
+    if (!newLedsP) {
+      ppf("dev allocLeds %d leds failed, keep %d\n", nrOfLeds, ledsPSize); //nrOfLeds > ledsPSize: pass 2 is skipped
+      return;
+    }
+
+    free(ledsP);
+    ledsP = newLedsP;
+    #ifdef STARLIGHT_DOUBLE_BUFFER
+      free(ledsDriver);
+      ledsDriver = newLedsDriver;
+      ledsD = ledsDriver;
+    #else
+      ledsD = ledsP;
+    #endif
+    ledsPSize = nrOfLeds;
+    ppf("allocLeds %d leds %d B %s\n", nrOfLeds, nrOfLeds * sizeof(CRGB), psramFound()?"PSRAM":"heap");
+
+    doAllocPins = true; //the drivers need the new ledsD
+  }
+#endif
+
+//the physical pixels of a layer, each once
+static void layerPixels(const LedsLayer &leds, uint16_t nrOfPixels, std::vector<uint16_t> &pixels) {
+  pixels.clear();
+  if (!leds.projection) { //projection none: the whole fixture
+    for (uint16_t indexP = 0; indexP < nrOfPixels; indexP++)
+      pixels.push_back(indexP);
+    return;
+  }
+  for (uint16_t indexV = 0; indexV < leds.mappingTableSizeUsed; indexV++)
+    if (leds.mappingTable[indexV].mapType == m_onePixel && leds.mappingTable[indexV].indexP < nrOfPixels)
+      pixels.push_back(leds.mappingTable[indexV].indexP);
+  for (const uint16_t indexP: leds.mappingTableIndexesFlat)
+    if (indexP < nrOfPixels)
+      pixels.push_back(indexP);
+}
+
+//called by LedModEffects::loop if the mapping or the active layers changed
+//the pixel sets of the active layers: the pixels in more then one set (sharedPixels) go to the layers own buffer (layerLeds), compositeLayers blends them into ledsP
+//a layer without shared pixels writes directly (most fixtures: layer 0 or layers on different parts of the fixture)
+void LedModFixture::composeLayers(uint32_t activeLayers) {
+  const uint16_t nrOfPixels = min(nrOfLeds, ledsPSize);
+  std::vector<uint16_t> pixels;
+
+  std::vector<uint8_t> nrOfLayers(nrOfPixels, 0); //active layers per physical pixel
+  uint8_t rowNr = 0;
+  for (LedsLayer *leds: layers) {
+    if (activeLayers & (1 << rowNr)) {
+      layerPixels(*leds, nrOfPixels, pixels);
+      for (const uint16_t indexP: pixels)
+        if (nrOfLayers[indexP] < UINT8_MAX) nrOfLayers[indexP]++;
+    }
+    rowNr++;
+  }
+
+  sharedPixels.clear();
+  for (uint16_t indexP = 0; indexP < nrOfPixels; indexP++)
+    if (nrOfLayers[indexP] > 1) sharedPixels.push_back(indexP);
+  if (sharedPixels.empty()) { //no memory if layers do not overlap
+    sharedPixels.shrink_to_fit();
+    sharedSlots.clear();
+    sharedSlots.shrink_to_fit();
+  } else {
+    sharedSlots.assign(ledsPSize, UINT16_MAX);
+    for (uint16_t slot = 0; slot < sharedPixels.size(); slot++)
+      sharedSlots[sharedPixels[slot]] = slot;
+  }
+
+  std::vector<bool> composited(nrOfPixels, false); //by an active layer before
+  rowNr = 0;
+  for (LedsLayer *leds: layers) {
+    leds->blendOverlap = false;
+    leds->copyIndexes.clear();
+    leds->blendIndexes.clear();
+
+    if (activeLayers & (1 << rowNr) && !sharedPixels.empty()) {
+      layerPixels(*leds, nrOfPixels, pixels);
+      for (const uint16_t indexP: pixels) {
+        const uint16_t slot = sharedSlots[indexP];
+        if (slot != UINT16_MAX) {
+          leds->blendOverlap = true;
+          if (composited[indexP])
+            leds->blendIndexes.push_back(slot);
+          else
+            leds->copyIndexes.push_back(slot);
+        }
+        composited[indexP] = true;
+      }
+    }
+
+    if (leds->blendOverlap) {
+      //in ledsP order for the compositor (slots are in ledsP order)
+      std::sort(leds->copyIndexes.begin(), leds->copyIndexes.end());
+      std::sort(leds->blendIndexes.begin(), leds->blendIndexes.end());
+      //only the shared pixels: 3 bytes per shared pixel per overlapping layer
+      leds->layerLeds.resize(sharedPixels.size());
+      leds->layerLeds.shrink_to_fit();
+      for (uint16_t slot = 0; slot < sharedPixels.size(); slot++)
+        leds->layerLeds[slot] = ledsP[sharedPixels[slot]]; //continue from what is shown
+    } else { //no memory for layers which write directly
+      leds->copyIndexes.shrink_to_fit();
+      leds->blendIndexes.shrink_to_fit();
+      leds->layerLeds.clear();
+      leds->layerLeds.shrink_to_fit();
+    }
+    ppf("composeLayers leds[%d] %s c:%d b:%d of %d shared\n", rowNr, leds->blendOverlap?"blend":"direct", leds->copyIndexes.size(), leds->blendIndexes.size(), sharedPixels.size());
+    rowNr++;
+  }
+
+  composedLayers = activeLayers;
+  doComposeLayers = false;
+}
+
+//called by LedModEffects::loop after all layers ran: the shared pixels from the layer buffers into ledsP, in layer order
+void LedModFixture::compositeLayers() {
+  for (LedsLayer *leds: layers) {
+    if (!leds->blendOverlap) continue;
+    for (const uint16_t slot: leds->copyIndexes)
+      ledsP[sharedPixels[slot]] = leds->layerLeds[slot];
+    blendPixels(ledsP, sharedPixels.data(), leds->layerLeds.data(), leds->blendIndexes.data(), leds->blendIndexes.size(), leds->blendMode, globalBlend);
+  }
+}
+
 #define headerBytesFixture 16 // so 680 pixels will fit in a PACKAGE_SIZE package ?
 
 void LedModFixture::addPixelsPre() {
-  ppf("addPixelsPre(%d) f:%d s:%d s:%d\n", pass, ledFactor, ledSize, ledShape);
+  ppfI(lc_mapping, "addPixelsPre(%d) f:%d s:%d s:%d\n", pass, ledFactor, ledSize, ledShape);
 
   if (pass == 1) {
     fixSize = {0, 0, 0}; //start counting
     nrOfLeds = 0; //start counting
-  } else if (nrOfLeds <= STARLIGHT_MAXLEDS) {
+  } else if (nrOfLeds <= ledsPSize) {
 
     // reset leds
     uint8_t rowNr = 0;
@@ -580,14 +1096,18 @@ void LedModFixture::addPixelsPre() {
 }
 
 void LedModFixture::addPixel(Coord3D pixel) {
-  // ppf("led{%d} %d,%d,%d\n", pass, pixel.x,pixel.y,pixel.z); //start.x, start.y, start.z, end.x, end.y, end.z start %d,%d,%d end %d,%d,%d
+  ppfV(lc_mapping, "led{%d} %d,%d,%d\n", pass, pixel.x, pixel.y, pixel.z);
   if (pass == 1) {
-    // ppf(".");
     fixSize = fixSize.maximum(pixel);
     nrOfLeds++;
-  } else if (nrOfLeds <= STARLIGHT_MAXLEDS) {
 
-    if (indexP < STARLIGHT_MAXLEDS) {
+    if (mappingCacheFile) {
+      uint16_t record[3] = {(uint16_t)pixel.x, (uint16_t)pixel.y, (uint16_t)pixel.z};
+      mappingCacheFile.write((uint8_t *)record, sizeof(record));
+    }
+  } else if (nrOfLeds <= ledsPSize) {
+
+    if (indexP < ledsPSize) {
 
       if (bytesPerPixel && doSendFixtureDefinition) {
         //send pixel to ui ...
@@ -600,7 +1120,7 @@ void LedModFixture::addPixel(Coord3D pixel) {
             //send the buffer and create a new one
             web->sendBuffer(wsBuf, true, nullptr, false);
             delay(50);
-            ppf("buffer sent i:%d p:%d r:%d r6:%d (1:%d m:%u)\n", indexP, previewBufferIndex, (nrOfLeds - indexP), (nrOfLeds - indexP) * 6, buffer[1], millis());
+            ppfD(lc_mapping, "buffer sent i:%d p:%d r:%d r6:%d (1:%d m:%u)\n", indexP, previewBufferIndex, (nrOfLeds - indexP), (nrOfLeds - indexP) * 6, buffer[1], millis());
 
             buffer[0] = 1; //userfun 1
             buffer[1] = UINT8_MAX;
@@ -631,7 +1151,7 @@ void LedModFixture::addPixel(Coord3D pixel) {
       } //for layers
     } //indexP < max
     else 
-      ppf("dev post indexP too high %d>=%d or %d p:%d,%d,%d\n", indexP, nrOfLeds, STARLIGHT_MAXLEDS, pixel.x, pixel.y, pixel.z);
+      ppfE(lc_mapping, "dev post indexP too high %d>=%d or %d p:%d,%d,%d\n", indexP, nrOfLeds, ledsPSize, pixel.x, pixel.y, pixel.z);
 
     indexP++; //also increase if no buffer created
   }
@@ -640,9 +1160,13 @@ void LedModFixture::addPixel(Coord3D pixel) {
 void LedModFixture::addPin(uint8_t pin) {
   // ppf("addPin{%d} %d\n", pass, pin);
   if (pass == 1) {
-  } else if (nrOfLeds <= STARLIGHT_MAXLEDS) {
+    if (mappingCacheFile) {
+      uint16_t record[3] = {UINT16_MAX, pin, 0};
+      mappingCacheFile.write((uint8_t *)record, sizeof(record));
+    }
+  } else if (nrOfLeds <= ledsPSize) {
     if (doAllocPins) {
-      ppf("addPin %d (%d %d)\n", pin, indexP, nrOfLeds);
+      ppfD(lc_mapping, "addPin %d (%d %d)\n", pin, indexP, nrOfLeds);
       //check if pin already allocated, if so, extend range in details
       PinObject pinObject = pinsM->pinObjects[pin];
       char details[32] = "";
@@ -676,12 +1200,15 @@ void LedModFixture::addPin(uint8_t pin) {
 }
 
 void LedModFixture::addPixelsPost() {
-  ppf("addPixelsPost(%d) indexP:%d b:%d dsfd:%d %d ms\n", pass, indexP, bytesPerPixel, doSendFixtureDefinition, millis() - start);
+  ppfI(lc_mapping, "addPixelsPost(%d) indexP:%d b:%d dsfd:%d %d ms\n", pass, indexP, bytesPerPixel, doSendFixtureDefinition, millis() - start);
   //after processing each led
   if (pass == 1) {
     fixSize = fixSize / ledFactor + Coord3D{1,1,1};
-    ppf("addPixelsPost(%d) size s:%d,%d,%d #:%d %d ms\n", pass, fixSize.x, fixSize.y, fixSize.z, nrOfLeds);
-  } else if (nrOfLeds <= STARLIGHT_MAXLEDS) {
+    ppfI(lc_mapping, "addPixelsPost(%d) size s:%d,%d,%d #:%d %d ms\n", pass, fixSize.x, fixSize.y, fixSize.z, nrOfLeds, millis() - start);
+    #ifdef STARLIGHT_WIDE_INDEX
+      allocLeds(); //nrOfLeds is known now
+    #endif
+  } else if (nrOfLeds <= ledsPSize) {
 
     if (bytesPerPixel && doSendFixtureDefinition) {
       if (wsBuf) {
@@ -690,7 +1217,7 @@ void LedModFixture::addPixelsPost() {
         buffer[13] = previewBufferIndex%256; //last slot filled
         web->sendBuffer(wsBuf, true, nullptr, false);
 
-        ppf("last buffer sent i:%d p:%d r:%d r6:%d (1:%d m:%u)\n", indexP, previewBufferIndex, (nrOfLeds - indexP), (nrOfLeds - indexP) * 6, buffer[1], millis());
+        ppfD(lc_mapping, "last buffer sent i:%d p:%d r:%d r6:%d (1:%d m:%u)\n", indexP, previewBufferIndex, (nrOfLeds - indexP), (nrOfLeds - indexP) * 6, buffer[1], millis());
 
         // ppf("addPixelsPost before unlock and clean:%d\n", indexP);
         wsBuf->unlock();
@@ -711,22 +1238,17 @@ void LedModFixture::addPixelsPost() {
       rowNr++;
     } // leds
 
-    ppf("addPixelsPost(%d) fixture P:%dx%dx%d -> %d\n", pass, fixSize.x, fixSize.y, fixSize.z, nrOfLeds);
+    ppfI(lc_mapping, "addPixelsPost(%d) fixture P:%dx%dx%d -> %d\n", pass, fixSize.x, fixSize.y, fixSize.z, nrOfLeds);
 
     mdl->setValue("fixture", "size", fixSize);
     mdl->setValue("fixture", "count", nrOfLeds);
 
-    //init pixelsToBlend
-    for (uint16_t i=0; i<nrOfLeds; i++) {
-      if (pixelsToBlend.size() < nrOfLeds)
-        pixelsToBlend.push_back(false);
-    }
-
-    ppf("addPixelsPost(%d) fixture.size = so:%d + l:(%d * %d) B %d ms\n", pass, sizeof(this), STARLIGHT_MAXLEDS, sizeof(CRGB), millis() - start); //56
+    ppfI(lc_mapping, "addPixelsPost(%d) fixture.size = so:%d + l:(%d * %d) B %d ms\n", pass, sizeof(this), ledsPSize, sizeof(CRGB), millis() - start); //56
   }
 
   if (pass == 2) {
     mappingStatus = 0; //not mapping
+    doComposeLayers = true; //blend masks for the new mappings
 
     //reinit the effect after an effect change causing a mapping change
     uint8_t rowNr = 0;
@@ -814,18 +1336,16 @@ void LedModFixture::addPixelsPost() {
 
     if (nb_pins > 0) {
       #if CONFIG_IDF_TARGET_ESP32S3 | CONFIG_IDF_TARGET_ESP32S2
-        driver.initled((uint8_t*) ledsP, pins, nb_pins, lengths[0]); //s3 doesn't support lengths so we pick the first
+        driver.initled((uint8_t*) ledsD, pins, nb_pins, lengths[0]); //s3 doesn't support lengths so we pick the first
         //void initled( uint8_t * leds, int * pins, int numstrip, int NUM_LED_PER_STRIP)
       #else
-        driver.initled((uint8_t*) ledsP, pins, lengths, nb_pins, (colorarrangment)colorOrder);
+        driver.initled((uint8_t*) ledsD, pins, lengths, nb_pins, (colorarrangment)colorOrder);
         #if STARLIGHT_LIVE_MAPPING
           driver.setMapLed(&mapLed);
         #endif
-        driver.setGamma(gammaRed/255.0, gammaGreen/255.0, gammaBlue/255.0);
         //void initled(uint8_t *leds, int *Pinsq, int *sizes, int num_strips, colorarrangment cArr)
       #endif
-      Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true); //set brightness (init is true so bri value not send via udp)
-      // driver.setBrightness(setMaxPowerBrightnessFactor / 256); //not brighter then the set limit (WIP)
+      Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true); //set gamma and brightness (init is true so bri value not send via udp)
     }
   }
   void LedModFixture::driverShow() {
@@ -865,7 +1385,7 @@ void LedModFixture::addPixelsPost() {
     }
     ppf("]\n");
 
-    for (int i=0; i< STARLIGHT_MAXLEDS; i++) ledsP[i] = CRGB::Black; //avoid very bright pixels during reboot (WIP)
+    for (int i=0; i< ledsPSize; i++) ledsD[i] = CRGB::Black; //avoid very bright pixels during reboot (WIP)
 
     pinsM->allocatePin(clockPin, "Leds", "Clock");
     pinsM->allocatePin(latchPin, "Leds", "Latch");
@@ -877,14 +1397,14 @@ void LedModFixture::addPixelsPost() {
         driver._clockspeed = clockFreq==10?clock_1000KHZ:clockFreq==11?clock_1111KHZ:clockFreq==12?clock_1123KHZ:clock_800KHZ;
         driver.setPins(pins, clockPin, latchPin);
       } else
-        driver.initled(ledsP, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size(), clockFreq==10?clock_1000KHZ:clockFreq==11?clock_1111KHZ:clockFreq==12?clock_1123KHZ:clock_800KHZ);
+        driver.initled(ledsD, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size(), clockFreq==10?clock_1000KHZ:clockFreq==11?clock_1111KHZ:clockFreq==12?clock_1123KHZ:clock_800KHZ);
     #else
       if (driver.driverInit) {
         NUM_LEDS_PER_STRIP = lengths[0]/8; //each shift register feeds 8 panels
         NBIS2SERIALPINS = sortedPins.size();
         driver.setPins(pins, clockPin, latchPin);
       } else
-        driver.initled(ledsP, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size());
+        driver.initled(ledsD, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size());
     #endif
 
     // driver.setColorOrderPerStrip(0, (colorarrangment)colorOrder); //to be implemented...
@@ -893,12 +1413,11 @@ void LedModFixture::addPixelsPost() {
     #if STARLIGHT_LIVE_MAPPING
       driver.setMapLed(&mapLed);
     #endif
-    driver.setGamma(gammaRed/255.0, gammaGreen/255.0, gammaBlue/255.0);
 
     // if (driver.driverInit) driver.showPixels(WAIT);  //avoid very bright pixels during reboot (WIP)
     driver.setBrightness(10); //avoid very bright pixels during reboot (WIP)
 
-    Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true); //set brightness (init is true so bri value not send via udp)
+    Variable("Fixture", "brightness").triggerEvent(onChange, UINT8_MAX, true); //set gamma and brightness (init is true so bri value not send via udp)
 
   }
   void LedModFixture::driverShow() {
@@ -929,203 +1448,207 @@ void LedModFixture::addPixelsPost() {
 
       switch (sortedPin.pin) {
       #if CONFIG_IDF_TARGET_ESP32
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !defined(BOARD_HAS_PSRAM) && !defined(ARDUINO_ESP32_PICO)
         // 16+17 = reserved for PSRAM, or reserved for FLASH on pico-D4
-        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 34-39 input-only
-        // case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32
 
       #if CONFIG_IDF_TARGET_ESP32S2
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !ARDUINO_USB_CDC_ON_BOOT
         // 19 + 20 = USB HWCDC. reserved for USB port when ARDUINO_USB_CDC_ON_BOOT=1
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 22 to 32: not connected, or reserved for SPI FLASH
-        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !defined(BOARD_HAS_PSRAM)
         // 26-32 = reserved for PSRAM
-        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
-        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 46 input-only
-        // case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32S2
 
       #if CONFIG_IDF_TARGET_ESP32C3
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 11-17 reserved for SPI FLASH
-        //case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !ARDUINO_USB_CDC_ON_BOOT
         // 18 + 19 = USB HWCDC. reserved for USB port when ARDUINO_USB_CDC_ON_BOOT=1
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
         // 20+21 = Serial RX+TX --> don't use for LEDS when serial-to-USB is needed
-        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32S2
 
       #if CONFIG_IDF_TARGET_ESP32S3
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #if !ARDUINO_USB_CDC_ON_BOOT
         // 19 + 20 = USB-JTAG. Not recommended for other uses.
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // // 22 to 32: not connected, or SPI FLASH
-        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #if !defined(BOARD_HAS_PSRAM)
         // 33 to 37: reserved if using _octal_ SPI Flash or _octal_ PSRAM
-        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif
-        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 43+44 = Serial RX+TX --> don't use for LEDS when serial-to-USB is needed
-        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 47: FastLED.addLeds<STARLIGHT_CHIPSET, 47>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 48: FastLED.addLeds<STARLIGHT_CHIPSET, 48>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 47: FastLED.addLeds<STARLIGHT_CHIPSET, 47>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 48: FastLED.addLeds<STARLIGHT_CHIPSET, 48>(ledsD, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32S3
 
       default: ppf("FastLEDPin assignment: pin not supported %d\n", sortedPin.pin);
       } //switch pinNr
     } //sortedPins
+
+    #ifdef STARLIGHT_WIDE_INDEX
+      ledsDAdded = true; //see allocLeds
+    #endif
   }
 
   void LedModFixture::driverShow() {
@@ -12,6 +12,7 @@
 #pragma once
 #include "SysModule.h"
 #include "../Sys/SysModModel.h"
+#include "../Sys/SysModFiles.h"
 
 #include "LedLayer.h"
 
@@ -60,17 +61,74 @@
   static WhateverHubDriver driver;
 #endif
 
+//gamma is only used if the leds get it too: from outputLut when the frame is handed over to the show task, or from the I2S drivers themselves
+//  FastLED and HUB75 without double buffer send ledsP with brightness only, so all outputs do
+#if defined(STARLIGHT_DOUBLE_BUFFER) || STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
+  #define STARLIGHT_OUTPUT_GAMMA
+#endif
+
 struct SortedPin {
   uint16_t startLed;
   uint16_t nrOfLeds;
   uint8_t pin;
 };
 
+//binary copy of a json fixture (/F_name.json -> /M_name.map) so the json only needs to be parsed once
+//header, then per pixel 3 x uint16_t x,y,z (x == UINT16_MAX: end of pin, y = pin), then trailer
+struct MappingCacheHeader {
+  uint32_t magic = 0x434D4C53; //SLMC
+  uint16_t version = 1;
+  uint16_t recordSize = 3 * sizeof(uint16_t);
+  //key: size and last write of the fixture file, then its hash (only read if size and last write match)
+  uint32_t fixtureSize = 0;
+  uint32_t fixtureTime = 0;
+  uint32_t fixtureHash = 0;
+
+  //all but the hash
+  bool sameFile(const MappingCacheHeader &other) const {
+    return magic == other.magic && version == other.version && recordSize == other.recordSize && fixtureSize == other.fixtureSize && fixtureTime == other.fixtureTime;
+  }
+};
+
+//written last, so a cache which is not completely written is not used
+struct MappingCacheTrailer {
+  uint32_t magic = 0x444E454D; //MEND
+  uint8_t ledFactor = 1;
+  uint8_t ledSize = 4;
+  uint8_t ledShape = 0;
+  uint8_t reserved = 0;
+};
+
 class LedModFixture: public SysModule {
 
 public:
 
-  CRGB ledsP[STARLIGHT_MAXLEDS];
+  #ifdef STARLIGHT_WIDE_INDEX
+    CRGB *ledsP = nullptr; //allocated for nrOfLeds in allocLeds, only grows
+    uint16_t ledsPSize = 0; //nr of leds allocated in ledsP (and ledsDriver)
+    bool ledsDAdded = false; //FastLED controllers point to ledsD and can not be removed: ledsD is not reallocated anymore
+    void allocLeds();
+  #else
+    CRGB ledsP[STARLIGHT_MAXLEDS];
+    const uint16_t ledsPSize = STARLIGHT_MAXLEDS;
+  #endif
+
+  #ifdef STARLIGHT_DOUBLE_BUFFER
+    //effects render the next frame in ledsP while the show task sends the previous frame from ledsDriver
+    #ifdef STARLIGHT_WIDE_INDEX
+      CRGB *ledsDriver = nullptr;
+      CRGB *ledsD = nullptr;
+    #else
+      CRGB ledsDriver[STARLIGHT_MAXLEDS];
+      CRGB *ledsD = ledsDriver;
+    #endif
+    SemaphoreHandle_t frameReady = nullptr; //given by loop when ledsDriver contains a new frame
+    SemaphoreHandle_t showDone = nullptr; //given by the show task when ledsDriver has been sent
+    uint16_t showCounter = 0; //frames sent by the show task, reset every second
+    uint16_t showFps = 0;
+  #else
+    CRGB *ledsD = ledsP; //the driver sends the leds as rendered
+  #endif
 
   // CRGB *leds = nullptr;
     // if (!leds)
@@ -81,14 +139,15 @@ public:
   // leds = (CRGB*)malloc(nrOfLeds * sizeof(CRGB));
   // leds = (CRGB*)reallocarray
 
-  std::vector<bool> pixelsToBlend; //this is a 1-bit vector !!! overlapping effects will blend
+  //overlapping layers blend: the pixels shared by active layers get a buffer per layer (LedsLayer::layerLeds)
+  std::vector<uint16_t> sharedPixels; //physical pixels in the pixel sets of more then one active layer, sorted
+  std::vector<uint16_t> sharedSlots; //per physical pixel: its index in sharedPixels, UINT16_MAX if not shared. Empty if no layers overlap
+  uint32_t composedLayers = 0; //active layers (bit per rowNr) of sharedPixels
+  bool doComposeLayers = true; //mapping changed
+  void composeLayers(uint32_t activeLayers);
+  void compositeLayers();
+
   LedModFixture() :SysModule("Fixture") {
-    //init pixelsToBlend
-    for (uint16_t i=0; i<nrOfLeds; i++) {
-      if (pixelsToBlend.size() < nrOfLeds)
-        pixelsToBlend.push_back(false);
-    }
-    ppf("Fixture constructor ptb:%d\n", pixelsToBlend.size());
 
     #ifdef STARLIGHT_PHYSICAL_DRIVER
       //'hack' to make sure show is not called before init
@@ -128,10 +187,40 @@ public:
   uint8_t bri = 10;
   uint8_t bytesPerPixel = 2;
 
+  //preview: after a key frame with all pixels only changed pixels are send
+  std::vector<uint8_t> previewFrame; //encoded pixels as the clients have them
+  uint32_t previewClientId = 0; //newest client when the last frame was send: a newer client (higher id) needs a key frame
+  bool previewResend = false; //a package was not send, next frame is a key frame
+  uint16_t previewInterval = 160; //ms, adapts to the websocket queues
+
   uint8_t gammaRed = 255;
   uint8_t gammaGreen = 176;
   uint8_t gammaBlue = 240;
 
+  //output transform per channel (r,g,b), used by all outputs
+  uint8_t outputBri = 0; //logarithmic brightness, 0 if off
+  uint8_t gammaLut[3][256] = {}; //gamma (STARLIGHT_OUTPUT_GAMMA) and outputBri: the leds as the drivers send them, made again if one of them changes
+  uint8_t outputLut[3][256] = {}; //gammaLut limited by powerBrightness, black until made
+  void makeOutputLut();
+  void setOutputBrightness();
+
+  //power limiter: current estimate of ledsP as send (gammaLut), brightness is limited to maxPowerWatt for all outputs
+  static constexpr uint8_t powerRedMilliAmps = 16; //per channel at full brightness and per led (idle) at 5V, as FastLED power_mgt
+  static constexpr uint8_t powerGreenMilliAmps = 11;
+  static constexpr uint8_t powerBlueMilliAmps = 15;
+  static constexpr uint8_t powerDarkMilliAmps = 1;
+  static constexpr uint8_t powerStep = 4; //max powerBrightness increase per frame
+  static const uint8_t powerPhases = 4; //each frame one of powerPhases pixels is summed, the estimate is the sum of the last powerPhases frames
+  uint32_t powerPhaseSums[powerPhases] = {}; //mA * 255
+  uint8_t powerPhase = 0;
+  uint32_t powerMilliAmps = 0; //estimate as send (limited by powerBrightness)
+  uint8_t powerBrightness = 255; //255: not limited
+  void estimatePower();
+
+  //cycles of LedModEffects compositeLayers and of driverShow, see Fixture "time"
+  PhaseProfile compositeProfile;
+  PhaseProfile showProfile;
+
   uint8_t fixtureNr = UINT8_MAX;
 
   std::vector<LedsLayer *> layers; //virtual leds
@@ -149,7 +238,7 @@ public:
   bool3State showTicker = false;
   char tickerTape[20] = "";
   bool3State showDriver = true;
-  uint16_t maxPowerWatt = 10; //default 10W, save for usb ports
+  uint16_t maxPowerWatt = 10; //default 10W, save for usb ports, 0: no limit
 
   //temporary here  
   uint16_t indexP = 0;
@@ -168,16 +257,19 @@ public:
   void addPin(uint8_t pin);
   void addPixelsPost();
   void driverInit(const std::vector<SortedPin> &sortedPins);
+
+  //mapping cache, see MappingCacheHeader
+  File mappingCacheFile; //open while pass 1 of a json fixture is recorded
+  bool mappingCacheName(char * cacheName, const char * fileName);
+  bool mappingCacheKey(const char * fileName, MappingCacheHeader &header);
+  uint32_t mappingCacheHash(const char * fileName);
+  bool mappingCacheReplay(const char * cacheName, const char * fileName, const MappingCacheHeader &header);
   void driverShow();
 
   #ifdef STARBASE_USERMOD_LIVE
     uint8_t liveFixtureID = UINT8_MAX;
   #endif
 
-  #if STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
-    uint8_t setMaxPowerBrightnessFactor = 90; //tbd: implement driver.setMaxPowerInMilliWatts
-  #endif
-
 };
 
 extern LedModFixture *fix;
\ No newline at end of file
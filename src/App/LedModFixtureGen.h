@@ -608,6 +608,7 @@ public:
     fixtureVariable.findOptionsText(fgValue, fgGroup, fgText);
 
     //remove all the variables
+    mdl->clearVarIndex();
     fixtureVar.remove("n"); //tbd: we should also remove the varEvent !!
 
     //part 0: group variables
@@ -303,9 +303,16 @@ class TiltPanRollProjection: public Projection {
   const char * name() override {return "TiltPanRoll";}
   const char * tags() override {return "💫";}
 
+  struct TiltPanRollData { // 6 bytes
+    uint16_t tilt; //angles of the current frame
+    uint16_t pan;
+    uint16_t roll;
+  };
+
   public:
 
   void setup(LedsLayer &leds, Variable parentVar) override {
+    leds.projectionData.readWrite<TiltPanRollData>(); //allocate before controls are added
     //tbd: implement variable by reference for rowNrs
     #ifdef STARBASE_USERMOD_MPU6050
       ui->initCheckBox(parentVar, "gyro", (bool3State)false, false, [&leds](EventArguments) { switch (eventType) {
@@ -355,30 +362,90 @@ class TiltPanRollProjection: public Projection {
     pixel.z += offset.z;
   }
 
+  //angles are calculated once per frame, XYZ results are only recalculated if one of them changed (as RotateProjection)
+  XYZCache XYZFrame(LedsLayer &leds) override {
+    TiltPanRollData *data = leds.projectionData.readWrite<TiltPanRollData>();
+
+    TiltPanRollData angles;
+    #ifdef STARBASE_USERMOD_MPU6050
+      if (leds.proGyro) {
+        angles.tilt = mpu6050->gyro.x;
+        angles.pan = mpu6050->gyro.y;
+        angles.roll = mpu6050->gyro.z;
+      }
+      else 
+    #endif
+    {
+      angles.tilt = leds.proTiltSpeed?sys->now * 5 / (255 - leds.proTiltSpeed):0;
+      angles.pan = leds.proPanSpeed?sys->now * 5 / (255 - leds.proPanSpeed):0;
+      angles.roll = leds.proRollSpeed?sys->now * 5 / (255 - leds.proRollSpeed):0;
+    }
+
+    if (angles.tilt == data->tilt && angles.pan == data->pan && angles.roll == data->roll)
+      return xyz_unchanged;
+
+    *data = angles;
+    return xyz_changed;
+  }
+
   void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+    TiltPanRollData *data = leds.projectionData.readWrite<TiltPanRollData>();
+
     #ifdef STARBASE_USERMOD_MPU6050
       if (leds.proGyro) {
-        pixel = trigoTiltPanRoll.tilt(pixel, leds.size/2, mpu6050->gyro.x);
-        pixel = trigoTiltPanRoll.pan(pixel, leds.size/2, mpu6050->gyro.y);
-        pixel = trigoTiltPanRoll.roll(pixel, leds.size/2, mpu6050->gyro.z);
+        pixel = trigoTiltPanRoll.tilt(pixel, leds.size/2, data->tilt);
+        pixel = trigoTiltPanRoll.pan(pixel, leds.size/2, data->pan);
+        pixel = trigoTiltPanRoll.roll(pixel, leds.size/2, data->roll);
       }
       else 
     #endif
     {
-      if (leds.proTiltSpeed) pixel = trigoTiltPanRoll.tilt(pixel, leds.size/2, sys->now * 5 / (255 - leds.proTiltSpeed));
-      if (leds.proPanSpeed) pixel = trigoTiltPanRoll.pan(pixel, leds.size/2, sys->now * 5 / (255 - leds.proPanSpeed));
-      if (leds.proRollSpeed) pixel = trigoTiltPanRoll.roll(pixel, leds.size/2, sys->now * 5 / (255 - leds.proRollSpeed));
+      if (leds.proTiltSpeed) pixel = trigoTiltPanRoll.tilt(pixel, leds.size/2, data->tilt);
+      if (leds.proPanSpeed) pixel = trigoTiltPanRoll.pan(pixel, leds.size/2, data->pan);
+      if (leds.proRollSpeed) pixel = trigoTiltPanRoll.roll(pixel, leds.size/2, data->roll);
       if (fix->fixSize.z == 1) pixel.z = 0; // 3d effects will be flattened on 2D fixtures
     }
   }
 }; //TiltPanRollProjection
 
 class DistanceFromPointProjection: public Projection {
-  const char * name() override {return "Distance ⌛";}
+  const char * name() override {return "Distance";}
   const char * tags() override {return "💫";}
 
   public:
 
+  //2D2D: the projected position of each virtual pixel is calculated once in addPixelsPre,
+  //  the table contains per projected position the first virtual pixel (x + y * size.x + 1, 0 is none) which lands on it
+  //  so addPixel is a lookup instead of a search of the whole virtual grid
+  uint16_t tableLength(LedsLayer &leds) {
+    if (leds.projectionDimension != _2D || leds.effectDimension != _2D || leds.size.x < 2 || leds.size.y < 2) return 0;
+    size_t length = (leds.size.x + 1) * (leds.size.y + 1); //projected positions are 0 .. size.x, 0 .. size.y
+    return (length * sizeof(uint16_t) < UINT16_MAX - 32)?length:0; //projectionData.bytesAllocated is 16 bits, else search
+  }
+
+  void addPixelsPre(LedsLayer &leds) override {
+    uint16_t length = tableLength(leds);
+    if (length == 0) return;
+
+    uint16_t *table = leds.projectionData.readWrite<uint16_t>(length); //initialized with 0
+    if (!leds.projectionData.success()) return;
+    memset(table, 0, length * sizeof(uint16_t)); //also if reused from the previous mapping
+
+    Trigo trigo(leds.size.x-1); // 8 bits trigo with period leds.size.x-1 (currentl Float trigo as same performance)
+    for (uint16_t x=0; x<leds.size.x; x++) {
+      float xNew = trigo.sin(leds.size.x, x);
+      float yNew = trigo.cos(leds.size.y, x);
+      for (uint16_t y=0; y<leds.size.y; y++) {
+        float yFactor = 1 - y / (leds.size.y-1.0f); // between 1 .. 0
+        int x2New = round((yFactor * xNew + leds.size.x) / 2.0f); // 0 .. size.x
+        int y2New = round((yFactor * yNew + leds.size.y) / 2.0f); //  0 .. size.y
+        if (x2New < 0 || x2New > leds.size.x || y2New < 0 || y2New > leds.size.y) continue;
+        uint16_t &entry = table[x2New + y2New * (leds.size.x + 1)];
+        if (entry == 0) entry = x + y * leds.size.x + 1; //first found, as the search did
+      }
+    }
+  }
+
   void addPixel(LedsLayer &leds, Coord3D &pixel) override {
     DefaultProjection dp;
     dp.addPixel(leds, pixel);
@@ -387,6 +454,20 @@ class DistanceFromPointProjection: public Projection {
 
   void postProcessing(LedsLayer &leds, Coord3D &pixel) {
     //2D2D: inverse mapping
+    uint16_t length = tableLength(leds);
+    if (length) {
+      uint16_t *table = leds.projectionData.readWrite<uint16_t>(length);
+      if (leds.projectionData.success()) {
+        uint16_t entry = (pixel.z == 0 && pixel.x >= 0 && pixel.x <= leds.size.x && pixel.y >= 0 && pixel.y <= leds.size.y)?table[pixel.x + pixel.y * (leds.size.x + 1)]:0;
+        if (entry == 0) {pixel.x = UINT16_MAX; return;} //do not show this pixel
+        pixel.x = (entry - 1) % leds.size.x;
+        pixel.y = (entry - 1) / leds.size.x;
+        pixel.z = 0;
+        return;
+      }
+    }
+
+    //no table: search the virtual grid
     Trigo trigo(leds.size.x-1); // 8 bits trigo with period leds.size.x-1 (currentl Float trigo as same performance)
     float minDistance = 10;
     for (uint16_t x=0; x<leds.size.x && minDistance > 0.5f; x++) {
@@ -403,24 +484,12 @@ class DistanceFromPointProjection: public Projection {
         float x2New = round((yFactor * xNew + leds.size.x) / 2.0f); // 0 .. size.x
         float y2New = round((yFactor * yNew + leds.size.y) / 2.0f); //  0 .. size.y
 
-        // ppf(" %d,%d->%f,%f->%f,%f", x, y, sinf(x * TWO_PI / (float)(size.x-1)), cosf(x * TWO_PI / (float)(size.x-1)), xNew, yNew);
-
-        //this should work (better) but needs more testing
-        // float distance = abs(indexV - xNew - yNew * size.x);
-        // if (distance < minDistance) {
-        //   minDistance = distance;
-        //   indexV = x+y*size.x;
-        // }
-
         // if the new XY i
         if (pixel == Coord3D({(int)x2New, (int)y2New, 0})) {
-          // ppf("  found one %d => %d=%d+%d*%d (%f+%f*%d) [%f]\n", x+y*size.x, x,y, size.x, xNew, yNew, size.x, distance);
           pixel.x = x;
           pixel.y = y;
           pixel.z = 0;
 
-          if (pixel.x%10 == 0) ppf("."); //show some progress as this projection is slow (Need S007 to optimize ;-)
-                                      
           minDistance = 0.0f; // stop looking further
         }
       }
@@ -856,18 +925,32 @@ class ScrollingProjection: public Projection {
   const char * name() override {return "Scrolling";}
   const char * tags() override {return "💫";}
 
+  struct ScrollingData {
+    uint8_t xSpeed;
+    uint8_t ySpeed;
+    uint8_t zSpeed;
+    Coord3D offset; //of the current frame, 0..size-1
+  };
+
+  //after the data of MirrorProjection: mirrorX, mirrorY, mirrorZ and originalSize
+  ScrollingData *scrollingData(LedsLayer &leds) {
+    leds.projectionData.readWrite<bool3State>(3);
+    leds.projectionData.readWrite<Coord3D>();
+    return leds.projectionData.readWrite<ScrollingData>();
+  }
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     MirrorProjection mp;
     mp.setup(leds, parentVar);
 
-    uint8_t *xSpeed  = leds.projectionData.write<uint8_t>(128);
-    uint8_t *ySpeed  = leds.projectionData.write<uint8_t>(0);
-    uint8_t *zSpeed  = leds.projectionData.write<uint8_t>(0);
+    leds.projectionData.readWrite<Coord3D>(); //originalSize, set by MirrorProjection::addPixelsPre, allocated here so it does not overwrite the speeds
+    ScrollingData *data = leds.projectionData.readWrite<ScrollingData>();
+    data->xSpeed = 128;
 
-    ui->initSlider(parentVar, "xSpeed", xSpeed, 0, 255, false);
+    ui->initSlider(parentVar, "xSpeed", &data->xSpeed, 0, 255, false);
     //ewowi: 2D/3D inits will be done automatically in the future, then the if's are not needed here
-    if (leds.projectionDimension >= _2D) ui->initSlider(parentVar, "ySpeed", ySpeed, 0, 255, false);
-    if (leds.projectionDimension == _3D) ui->initSlider(parentVar, "zSpeed", zSpeed, 0, 255, false);
+    if (leds.projectionDimension >= _2D) ui->initSlider(parentVar, "ySpeed", &data->ySpeed, 0, 255, false);
+    if (leds.projectionDimension == _3D) ui->initSlider(parentVar, "zSpeed", &data->zSpeed, 0, 255, false);
   }
 
   void addPixelsPre(LedsLayer &leds) override {
@@ -880,18 +963,30 @@ class ScrollingProjection: public Projection {
     mp.addPixel(leds, pixel);
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
-    bool3State mirrorX = leds.projectionData.read<bool3State>(); // Not used 
-    bool3State mirrorY = leds.projectionData.read<bool3State>(); // Not used
-    bool3State mirrorZ = leds.projectionData.read<bool3State>(); // Not used
+  //the offsets are calculated once per frame, XYZ results are only recalculated if one of them changed
+  XYZCache XYZFrame(LedsLayer &leds) override {
+    ScrollingData *data = scrollingData(leds);
+
+    Coord3D offset;
+    offset.x = data->xSpeed?(sys->now * data->xSpeed / 255 / 100) % leds.size.x:0;
+    offset.y = data->ySpeed?(sys->now * data->ySpeed / 255 / 100) % leds.size.y:0;
+    offset.z = data->zSpeed?(sys->now * data->zSpeed / 255 / 100) % leds.size.z:0;
 
-    uint8_t xSpeed = leds.projectionData.read<uint8_t>();
-    uint8_t ySpeed = leds.projectionData.read<uint8_t>();
-    uint8_t zSpeed = leds.projectionData.read<uint8_t>();
+    if (offset == data->offset)
+      return xyz_unchanged;
+
+    data->offset = offset;
+    return xyz_changed;
+  }
+
+  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+    const ScrollingData *data = scrollingData(leds);
 
-    if (xSpeed) pixel.x = (pixel.x + (sys->now * xSpeed / 255 / 100)) % leds.size.x;
-    if (ySpeed) pixel.y = (pixel.y + (sys->now * ySpeed / 255 / 100)) % leds.size.y;
-    if (zSpeed) pixel.z = (pixel.z + (sys->now * zSpeed / 255 / 100)) % leds.size.z;
+    //offset < size: pixels of the layer wrap around with one subtraction
+    pixel += data->offset;
+    if (pixel.x >= leds.size.x) pixel.x -= leds.size.x;
+    if (pixel.y >= leds.size.y) pixel.y -= leds.size.y;
+    if (pixel.z >= leds.size.z) pixel.z -= leds.size.z;
   }
 }; //ScrollingProjection
 
@@ -907,6 +1002,7 @@ class AccelerationProjection: public Projection {
     bool3State *wrap = leds.projectionData.write<bool3State>(false);
     uint8_t *sensitivity = leds.projectionData.write<uint8_t>(0);
     uint8_t *deadzone = leds.projectionData.write<uint8_t>(10);
+    leds.projectionData.readWrite<Coord3D>(); //move of the current frame, set by XYZFrame
 
     ui->initCheckBox(parentVar, "wrap", wrap);
     ui->initSlider(parentVar, "sensitivity", sensitivity, 0, 100, false);
@@ -918,10 +1014,12 @@ class AccelerationProjection: public Projection {
     dp.addPixel(leds, pixel);
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
-    bool3State wrap = leds.projectionData.read<bool3State>();
+  //the move is calculated once per frame from the accelerometer, XYZ results are only recalculated if it changed
+  XYZCache XYZFrame(LedsLayer &leds) override {
+    leds.projectionData.read<bool3State>(); //wrap
     float sensitivity = float(leds.projectionData.read<uint8_t>()) / 20.0 + 1; // 0 - 100 slider -> 1.0 - 6.0 multiplier 
     uint16_t deadzone = map(leds.projectionData.read<uint8_t>(), 0, 255, 0 , 1000); // 0 - 1000
+    Coord3D *move = leds.projectionData.readWrite<Coord3D>();
 
     int accelX = mpu6050->accell.x; 
     int accelY = mpu6050->accell.y;
@@ -929,13 +1027,27 @@ class AccelerationProjection: public Projection {
     if (abs(accelX) < deadzone) accelX = 0;
     if (abs(accelY) < deadzone) accelY = 0;
 
-    int xMove = map(accelX, -32768, 32767, -leds.size.x, leds.size.x) * sensitivity;
-    int yMove = map(accelY, -32768, 32767, -leds.size.y, leds.size.y) * sensitivity;
+    Coord3D newMove;
+    newMove.x = map(accelX, -32768, 32767, -leds.size.x, leds.size.x) * sensitivity;
+    newMove.y = map(accelY, -32768, 32767, -leds.size.y, leds.size.y) * sensitivity;
+    newMove.z = 0;
 
-    // if (pixel.x == 0 && pixel.y == 0) ppf("Accel: %d %d xMove: %d yMove: %d\n", accelX, accelY, xMove, yMove);
-  
-    pixel.x += xMove;
-    pixel.y += yMove;
+    // ppf("Accel: %d %d xMove: %d yMove: %d\n", accelX, accelY, newMove.x, newMove.y);
+
+    if (newMove == *move)
+      return xyz_unchanged;
+
+    *move = newMove;
+    return xyz_changed;
+  }
+
+  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+    bool3State wrap = leds.projectionData.read<bool3State>();
+    leds.projectionData.readWrite<uint8_t>(2); //sensitivity and deadzone, used by XYZFrame
+    Coord3D move = leds.projectionData.read<Coord3D>();
+
+    pixel.x += move.x;
+    pixel.y += move.y;
     if (wrap) {
       pixel.x %= leds.size.x;
       pixel.y %= leds.size.y;
@@ -1097,10 +1209,11 @@ class RotateProjection: public Projection {
     dp.addPixel(leds, pixel);
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
-    RotateData *data = leds.projectionData.readWrite<RotateData>();
+  static constexpr int Fixed_Scale = 1 << 10;
 
-    constexpr int Fixed_Scale = 1 << 10;
+  //shear values are updated once per frame, XYZ results are only recalculated if the angle changed
+  XYZCache XYZFrame(LedsLayer &leds) override {
+    RotateData *data = leds.projectionData.readWrite<RotateData>();
 
     if ((sys->now - data->lastUpdate > data->interval) && data->speed) { // Only update if the angle has changed
       data->lastUpdate = sys->now;
@@ -1118,8 +1231,15 @@ class RotateProjection: public Projection {
       float angleRadians = radians(newAngle);
       data->shearX = -tan(angleRadians / 2) * Fixed_Scale;
       data->shearY =  sin(angleRadians)     * Fixed_Scale;
+      return xyz_changed;
     }
 
+    return xyz_unchanged;
+  }
+
+  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+    RotateData *data = leds.projectionData.readWrite<RotateData>();
+
     int maxX = leds.size.x;
     int maxY = leds.size.y;
 
@@ -1183,28 +1303,18 @@ class RippleYZ: public Projection {
     bool3State towardsY = leds.projectionData.read<bool3State>();
     bool3State towardsZ = leds.projectionData.read<bool3State>();
 
+    //XYZ is not used by RippleYZ: rows and planes are consecutive indexV's, moved in bulk
+
     //1D->2D: each X is rippled through the y-axis
     if (towardsY) {
-      if (leds.effectDimension == _1D && leds.projectionDimension > _1D) {
-        for (int y=leds.size.y-1; y>=1; y--) {
-          for (int x=0; x<leds.size.x; x++) {
-            leds.setPixelColor({x, y, 0}, leds.getPixelColor({x,y-1,0}));
-          }
-        }
-      }
+      if (leds.effectDimension == _1D && leds.projectionDimension > _1D)
+        leds.moveRange(0, leds.size.x * (leds.size.y - 1), leds.size.x); //rows of plane 0
     }
 
     //2D->3D: each XY plane is rippled through the z-axis
     if (towardsZ) { //not relevant for 2D fixtures
-      if (leds.effectDimension < _3D && leds.projectionDimension == _3D) {
-        for (int z=leds.size.z-1; z>=1; z--) {
-          for (int y=0; y<leds.size.y; y++) {
-            for (int x=0; x<leds.size.x; x++) {
-              leds.setPixelColor({x, y, z}, leds.getPixelColor({x,y,z-1}));
-            }
-          }
-        }
-      }
+      if (leds.effectDimension < _3D && leds.projectionDimension == _3D)
+        leds.moveRange(0, leds.size.x * leds.size.y * (leds.size.z - 1), leds.size.x * leds.size.y);
     }
   }
 }; //RippleYZ
\ No newline at end of file
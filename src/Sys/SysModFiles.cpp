@@ -40,6 +40,12 @@ void SysModFiles::setup() {
         // ppf("files onDelete %s[%d] = %s %s\n", variable.id(), rowNr, variable.valueString().c_str(), fileName);
         this->removeFiles(fileName, false);
 
+        if (this->onDeleteFile) {
+          char path[32] = "/";
+          strlcat(path, fileName, sizeof(path));
+          this->onDeleteFile(path);
+        }
+
         #ifdef STARBASE_USERMOD_LIVE
           if (strnstr(fileName, ".sc", 32) != nullptr) {
             char name[32]="del:/"; //del:/ is recognized by LiveM->loop20ms
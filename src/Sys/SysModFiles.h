@@ -24,6 +24,8 @@ public:
   std::vector<uint16_t> fileSizes;
   std::vector<uint16_t> fileTimes;
 
+  std::function<void(const char *)> onDeleteFile = nullptr; //called with /name of a file deleted in the files table, e.g. to remove files derived from it
+
   SysModFiles();
   void setup() override;
   void loop20ms() override;
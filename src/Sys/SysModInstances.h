@@ -378,7 +378,7 @@ public:
 
         if (packetSize == sizeof(UDPWLEDSyncMessage)) { //1193 bytes
 
-          ppf("handleNotifications WLED sync ...%d %d %d\n", notifierUdp.remoteIP()[3], packetSize, sizeof(UDPWLEDSyncMessage));
+          ppfD(lc_network, "handleNotifications WLED sync ...%d %d %d\n", notifierUdp.remoteIP()[3], packetSize, sizeof(UDPWLEDSyncMessage));
 
           UDPWLEDSyncMessage wledSyncMessage;
           byte *udpIn = (byte *)&wledSyncMessage;
@@ -388,7 +388,7 @@ public:
           //   Serial.printf("%d: %d\n", i, udpIn[i]);
           // }
 
-          ppf("   %d %d p:%d\n", wledSyncMessage.bri, wledSyncMessage.mainsegMode, packetSize); //LEDs specific
+          ppfD(lc_network, "   %d %d p:%d\n", wledSyncMessage.bri, wledSyncMessage.mainsegMode, packetSize); //LEDs specific
 
           InstanceInfo *instance = findInstance(notifierUdp.remoteIP()); //if not exist, created
 
@@ -438,7 +438,7 @@ public:
           // }
           // Serial.println();
 
-          ppf("instances handleNotifications %d\n", notifierUdp.remoteIP()[3]);
+          ppfD(lc_network, "instances handleNotifications %d\n", notifierUdp.remoteIP()[3]);
           for (JsonObject childVar: Variable("Instances", "instances").children())
             Variable(childVar).triggerEvent(onSetValue); //set the value (WIP) ); //rowNr //instance - instances.begin()
 
@@ -446,7 +446,7 @@ public:
           web->recvUDPBytes+=packetSize;
         }
         else
-          ppf("dev WLED sync massage not size %d\n", sizeof(UDPWLEDSyncMessage));
+          ppfE(lc_network, "dev WLED sync massage not size %d\n", sizeof(UDPWLEDSyncMessage));
 
         return;
       }
@@ -458,7 +458,7 @@ public:
 
       if (packetSize > 0) {
         // IPAddress remoteIp = instanceUDP.remoteIP();
-        // ppf("handleNotifications instances ...%d %d check %d or %d\n", instanceUDP.remoteIP()[3], packetSize, sizeof(UDPWLEDMessage), sizeof(UDPStarMessage));
+        ppfV(lc_network, "handleNotifications instances ...%d %d check %d or %d\n", instanceUDP.remoteIP()[3], packetSize, sizeof(UDPWLEDMessage), sizeof(UDPStarMessage));
 
         bool found = false;
 
@@ -467,7 +467,7 @@ public:
           byte *udpIn = (byte *)&starMessage.header;
           instanceUDP.read(udpIn, packetSize);
 
-          // ppf("WLED instance %s received: size: %d\n", instanceUDP.remoteIP().toString().c_str(), packetSize);
+          ppfV(lc_network, "WLED instance %s received: size: %d\n", instanceUDP.remoteIP().toString().c_str(), packetSize);
           // for (int i=0; i<44; i++) {
           //   Serial.printf("%d: %d\n", i, udpIn[i]);
           // }
@@ -485,7 +485,7 @@ public:
           byte *udpIn = (byte *)&starMessage;
           instanceUDP.read(udpIn, packetSize);
 
-          // ppf("Star instance %s received: size: %d\n", instanceUDP.remoteIP().toString().c_str(), packetSize);
+          ppfV(lc_network, "Star instance %s received: size: %d\n", instanceUDP.remoteIP().toString().c_str(), packetSize);
 
           if (starMessage.header.ip0 == net->localIP()[0]) { // checksum - no other type of message
             updateInstance(starMessage);
@@ -500,7 +500,7 @@ public:
           JsonDocument message;
           DeserializationError error = deserializeJson(message, buffer);
           if (error)
-            ppf("handleNotifications i:%d no json l: %d e:%s\n", instanceUDP.remoteIP()[3], strnlen(buffer, packetSize), error.c_str());
+            ppfE(lc_network, "handleNotifications i:%d no json l: %d e:%s\n", instanceUDP.remoteIP()[3], strnlen(buffer, packetSize), error.c_str());
           else {
             if (instanceUDP.remoteIP()[3] != net->localIP()[3]) { //only others
 
@@ -509,14 +509,14 @@ public:
               char group2[32];
               if (groupOfName(instance->name, group1) && groupOfName(mdl->getValue("System", "name"), group2) && strncmp(group1, group2, sizeof(group1)) == 0) {
                   if (!message["id"].isNull() && !message["value"].isNull()) {
-                    ppf("handleNotifications i:%d json message %.*s l:%d\n", instanceUDP.remoteIP()[3], packetSize, buffer, packetSize);
+                    ppfD(lc_network, "handleNotifications i:%d json message %.*s l:%d\n", instanceUDP.remoteIP()[3], packetSize, buffer, packetSize);
 
                     Variable(message["pid"].as<const char *>(), message["id"].as<const char *>()).setValueJV(message["value"]);
                   }
                 }
               }
             else
-              ppf("handleNotifications self i:%d b:%.*s\n", instanceUDP.remoteIP()[3], packetSize, buffer);
+              ppfD(lc_network, "handleNotifications self i:%d b:%.*s\n", instanceUDP.remoteIP()[3], packetSize, buffer);
           }
         }
 
@@ -625,7 +625,7 @@ public:
         });
 
         serializeJson(instance.jsonData, starMessage.jsonString);
-        // ppf("sendSysInfoUDP ip:%d s:%s\n", instance.ip[3], starMessage.jsonString);
+        ppfV(lc_network, "sendSysInfoUDP ip:%d s:%s\n", instance.ip[3], starMessage.jsonString);
         // print->printJson(" d:", instance.jsonData);
         // print->printJDocInfo("   info", instance.jsonData);
       }
@@ -645,7 +645,7 @@ public:
       instanceUDP.endPacket();
     }
     else {
-      ppf("sendSysInfoUDP error\n");
+      ppfE(lc_network, "sendSysInfoUDP error\n");
     }
     // if (0 != instanceUDP.beginPacket(IPAddress(255, 255, 255, 255), instanceUDPPort)) {  // WLEDMM beginPacket == 0 --> error
     //   ppf("sendSysInfoUDP %s s:%d p:%d i:...%d\n", starMessage.header.name, sizeof(UDPWLEDMessage), instanceUDPPort, localIP[3]);
@@ -683,7 +683,7 @@ public:
       web->sendUDPCounter++;
       web->sendUDPBytes+=len;
       instanceUDP.endPacket();
-      ppf("sendMessageUDP ip:%d b:%.*s\n", ip[3], len, buffer);
+      ppfD(lc_network, "sendMessageUDP ip:%d b:%.*s\n", ip[3], len, buffer);
     }
   }
 
@@ -696,7 +696,7 @@ public:
         instanceFound = true;
     }
 
-    // ppf("updateInstance Instance: ...%d n:%s found:%d\n", messageIP[3], udpStarMessage.header.name, instanceFound);
+    ppfV(lc_network, "updateInstance Instance: ...%d n:%s found:%d\n", messageIP[3], udpStarMessage.header.name, instanceFound);
 
     if (!instanceFound) { //new instance
       InstanceInfo instance;
@@ -776,7 +776,7 @@ public:
                 //check if instance belongs to the same group
 
                 for (JsonPair pair: newData.as<JsonObject>()) {
-                  // ppf("updateInstance sync from i:%s k:%s v:%s\n", instance.name, pair.key().c_str(), pair.value().as<String>().c_str());
+                  ppfV(lc_network, "updateInstance sync from i:%s k:%s v:%s\n", instance.name, pair.key().c_str(), pair.value().as<String>().c_str());
 
                   char pid[32];
                   strlcpy(pid, pair.key().c_str(), sizeof(pid));
@@ -80,6 +80,7 @@
         varChild.remove("o");
       }
     else {
+      mdl->clearVarIndex();
       var["n"].to<JsonArray>(); //delete old values
     }
 
@@ -117,6 +118,7 @@
             }
             if (allNull) {
               ppf("remove allnulls %s\n", childVariable.id());
+              mdl->clearVarIndex();
               children().remove(childVarIt);
             }
           }
@@ -127,6 +129,7 @@
           if (childVar["o"].isNull()) { //if not updated
             ppf("varPostDetails %s.%s <- null\n", id(), childVariable.id());
             print->printJson("remove", childVar);
+            mdl->clearVarIndex();
             children().remove(childVarIt);
           }
         }
@@ -582,6 +585,7 @@ void SysModModel::setup() {
         if (var["o"].isNull()) { //!variable.var.isNull() &&  || variable.order() <= 0
           ppf("deleteObsolete remove var %s.%s (no order)\n", variable.pid()?variable.pid():"-", variable.id());          
             // vars.remove(var); //remove the obsolete var (no o or )
+          clearVarIndex();
           for (JsonArray::iterator it=vars.begin(); it!=vars.end(); ++it) if ((*it)["id"] == var["id"]) vars.remove(it); //use iterator to make .remove work!!!
         }
         return JsonObject(); //don't stop
@@ -599,6 +603,15 @@ void SysModModel::setup() {
   currentVar.subscribe(onLoop1s, [this](EventArguments) {
     variable.setValueF("%d x %d = %d (%d + %d + %d)", varEventsPS.size(), sizeof(VarEventPS), varEventsPS.size() * sizeof(VarEventPS), sizeof(Variable), sizeof(VarFunction), sizeof(uint8_t));
   });
+  currentVar = ui->initText(parentVar, "findVar", nullptr, 32, true);
+  currentVar.setComment("Per second: index hits, model walks");
+  currentVar.subscribe(onLoop1s, [this](EventArguments) {
+    variable.setValueF("%lu in %lu µs, %lu in %lu µs (%d)", findVarIndexed, findVarIndexedMicros, findVarWalked, findVarWalkedMicros, varIndex.size());
+    findVarIndexed = 0;
+    findVarIndexedMicros = 0;
+    findVarWalked = 0;
+    findVarWalkedMicros = 0;
+  });
 
   #endif //STARBASE_DEVMODE
 }
@@ -682,6 +695,9 @@ Variable SysModModel::initVar(Variable parent, const char * id, const char * typ
     variable = Variable(var);
 
     var["pid"] = parentId;
+    xSemaphoreTake(varIndexMutex, portMAX_DELAY);
+    varIndex[varHash(parentId, id)] = var;
+    xSemaphoreGive(varIndexMutex);
 
     if (var["ro"].isNull() || variable.readOnly() != readOnly) variable.readOnly(readOnly);
 
@@ -756,7 +772,42 @@ JsonObject SysModModel::walkThroughModel(std::function<JsonObject(JsonObject, Js
 }
 
 JsonObject SysModModel::findVar(const char * pid, const char * id, JsonObject parentVar) {
-  for (JsonObject var : parentVar.isNull()?model->as<JsonArray>():parentVar["n"]) {
+  if (parentVar.isNull()) { //not recursive: use the index, walk the model if not indexed
+    #ifdef STARBASE_DEVMODE
+      unsigned long start = micros();
+    #endif
+    uint32_t hash = varHash(pid, id);
+    JsonObject var;
+    xSemaphoreTake(varIndexMutex, portMAX_DELAY);
+    auto indexIt = varIndex.find(hash);
+    if (indexIt != varIndex.end()) var = indexIt->second;
+    xSemaphoreGive(varIndexMutex);
+    if (!var.isNull() && var["pid"] == pid && var["id"] == id) { //check as different pid.id can have the same hash
+      #ifdef STARBASE_DEVMODE
+        findVarIndexed++;
+        findVarIndexedMicros += micros() - start;
+      #endif
+      return var;
+    }
+    var = JsonObject();
+    for (JsonObject moduleVar : model->as<JsonArray>()) {
+      if (moduleVar["pid"] == pid && moduleVar["id"] == id) var = moduleVar;
+      else if (!moduleVar["n"].isNull()) var = findVar(pid, id, moduleVar);
+      if (!var.isNull()) break;
+    }
+    if (!var.isNull()) {
+      xSemaphoreTake(varIndexMutex, portMAX_DELAY);
+      varIndex[hash] = var;
+      xSemaphoreGive(varIndexMutex);
+    }
+    #ifdef STARBASE_DEVMODE
+      findVarWalked++;
+      findVarWalkedMicros += micros() - start;
+    #endif
+    return var;
+  }
+
+  for (JsonObject var : parentVar["n"].as<JsonArray>()) {
     if (var["pid"] == pid && var["id"] == id) { //(!pid && var["pid"] == pid) && 
       // Serial.printf("findVar found %s.%s!!\n", pid, id);
       return var;
@@ -773,6 +824,15 @@ JsonObject SysModModel::findVar(const char * pid, const char * id, JsonObject pa
   return JsonObject();
 }
 
+//FNV-1a of pid, '.' and id
+uint32_t SysModModel::varHash(const char * pid, const char * id) {
+  uint32_t hash = 2166136261;
+  for (const char *c = pid?pid:""; *c; c++) hash = (hash ^ (uint8_t)*c) * 16777619;
+  hash = (hash ^ '.') * 16777619;
+  for (const char *c = id?id:""; *c; c++) hash = (hash ^ (uint8_t)*c) * 16777619;
+  return hash;
+}
+
 JsonObject SysModModel::findModule(const char * pid, const char * id) {
   // if (model->isNull()) return JsonObject();
 
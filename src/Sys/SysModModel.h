@@ -14,6 +14,7 @@
 #include "SysModPrint.h"
 #include "SysModWeb.h"
 // #include "SysModules.h" //isConnected
+#include <unordered_map>
 
 struct Coord3D {
   int x;
@@ -363,6 +364,17 @@ public:
   std::vector<VarEvent> varEvents;
   std::vector<VarEventPS> varEventsPS;
 
+  //findVar index: hash of pid and id -> var. Added by initVar and findVar, cleared by clearVarIndex when vars are removed from the model
+  //findVar also runs in the AsyncTCP task (processJson), so varIndex is only used with varIndexMutex taken
+  std::unordered_map<uint32_t, JsonObject> varIndex;
+  SemaphoreHandle_t varIndexMutex = xSemaphoreCreateMutex();
+  #ifdef STARBASE_DEVMODE
+    unsigned long findVarIndexed = 0; //findVar counters, index hits and model walks, reset each second
+    unsigned long findVarIndexedMicros = 0;
+    unsigned long findVarWalked = 0;
+    unsigned long findVarWalkedMicros = 0;
+  #endif
+
   uint8_t resetPresetThreshold = 1; //can be lowered by preset.onchange and highered by processJson, if > 1 (not lowered but highered) then reset is allowed
 
   SysModModel();
@@ -399,6 +411,13 @@ public:
   //returns the var defined by id (parent to recursively call findVar)
   JsonObject walkThroughModel(std::function<JsonObject(JsonObject, JsonObject)> fun, JsonObject parentVar = JsonObject());
   JsonObject findVar(const char * pid, const char * id, JsonObject parentVar = JsonObject());
+  //empties the findVar index, call when vars are removed from the model: the index holds JsonObjects which are not valid after that
+  void clearVarIndex() {
+    xSemaphoreTake(varIndexMutex, portMAX_DELAY);
+    varIndex.clear();
+    xSemaphoreGive(varIndexMutex);
+  }
+  uint32_t varHash(const char * pid, const char * id);
   JsonObject findModule(const char * pid, const char * id);
   void findVars(const char * id, bool value, FindFun fun, JsonObject parentVar = JsonObject());
 
@@ -17,8 +17,25 @@
 #include "SysModSystem.h"
 #include "SysModules.h"
 
+#define PRINT_DRAIN_MS 10
+
+//low priority, on core 0 as the loop task never blocks on core 1: Serial waits for the uart here and not in the task printing
+static void printTask(void * parameter) {
+  SysModPrint *self = (SysModPrint *)parameter; //print is assigned after the constructor which starts this task
+  for (;;) {
+    self->drain(1);
+    vTaskDelay(pdMS_TO_TICKS(PRINT_DRAIN_MS));
+  }
+}
+
 SysModPrint::SysModPrint() :SysModule("Print") {
 
+  for (size_t i = 0; i < PRINT_LINES; i++)
+    lines[i].sequence.store(i, std::memory_order_relaxed);
+
+  for (uint8_t &level: logLevels)
+    level = min(LOG_INFO, STARBASE_LOG_LEVEL);
+
 #if ARDUINO_USB_CDC_ON_BOOT || !defined(CONFIG_IDF_TARGET_ESP32S2)
   Serial.begin(115200);
 #else
@@ -50,6 +67,9 @@ SysModPrint::SysModPrint() :SysModule("Print") {
   }
   Serial.println("Ready.\n");
   if (Serial) Serial.flush(); // drain output buffer
+
+  if (xTaskCreatePinnedToCore(printTask, "Print", 3072, this, 1, &printTaskHandle, 0) != pdPASS)
+    printTaskHandle = nullptr; //printf drains
 };
 
 void SysModPrint::setup() {
@@ -58,7 +78,7 @@ void SysModPrint::setup() {
   const Variable parentVar = ui->initSysMod(Variable(), name, 2302);
 
   //default to Serial
-  ui->initSelect(parentVar, "output", 1, false, [](EventArguments) { switch (eventType) {
+  ui->initSelect(parentVar, "output", &output, false, [](EventArguments) { switch (eventType) {
     case onUI:
     {
       JsonArray options = variable.setOptions();
@@ -73,52 +93,148 @@ void SysModPrint::setup() {
   }});
 
   ui->initTextArea(parentVar, "log");
+
+  //read only: a row per LogCategory, no rows added or deleted
+  Variable tableVar = ui->initTable(parentVar, "logLevels", nullptr, true, [](EventArguments) { switch (eventType) {
+    case onUI:
+      variable.setComment("Levels above the build level (STARBASE_LOG_LEVEL) are not compiled");
+      return true;
+    default: return false;
+  }});
+
+  ui->initText(tableVar, "category", nullptr, 32, true, [](EventArguments) { switch (eventType) {
+    case onSetValue: {
+      const char * categoryNames[] = {"System", "Mapping", "Effects", "Json", "Network", "Live"};
+      static_assert(sizeof(categoryNames) / sizeof(categoryNames[0]) == lc_count, "a name per log category");
+      for (uint8_t rowNr = 0; rowNr < lc_count; rowNr++)
+        variable.setValue(JsonString(categoryNames[rowNr]), rowNr);
+      return true; }
+    default: return false;
+  }});
+
+  ui->initNumber(tableVar, "level", UINT16_MAX, LOG_OFF, STARBASE_LOG_LEVEL, false, [this](EventArguments) { switch (eventType) {
+    case onSetValue:
+      for (uint8_t rowNr = 0; rowNr < lc_count; rowNr++)
+        variable.setValue(logLevels[rowNr], rowNr);
+      return true;
+    case onUI:
+      variable.setComment("0: off, 1: error, 2: warning, 3: info, 4: debug, 5: verbose");
+      return true;
+    case onChange:
+      if (rowNr < lc_count)
+        logLevels[rowNr] = min(variable.value(rowNr).as<uint8_t>(), (uint8_t)STARBASE_LOG_LEVEL);
+      return true;
+    default: return false;
+  }});
+
+  Variable currentVar = ui->initText(parentVar, "status", nullptr, 48, true);
+  currentVar.setComment("Per second, dropped: ring buffer full (total)");
+  currentVar.subscribe(onLoop1s, [this](EventArguments) {
+    const unsigned long dropped = droppedCounter.exchange(0);
+    droppedTotal += dropped;
+    variable.setValueF("%lu lines %lu B %lu dropped (%lu)", linesCounter, bytesCounter, dropped, droppedTotal);
+    linesCounter = 0;
+    bytesCounter = 0;
+  });
 }
 
 void SysModPrint::loop20ms() {
   if (!setupsDone) setupsDone = true;
+
+  drain(2); //the response object is only used in the loop task
+}
+
+uint8_t SysModPrint::target() {
+  return mdls->isConnected?output:1;
 }
 
 void SysModPrint::printf(const char * format, ...) {
-  va_list args;
+  const uint8_t to = target();
+  if (to != 1 && to != 2) return; //No (or not supported yet): not even formatted
+
+  const bool asyncTask = strncmp(pcTaskGetTaskName(nullptr), "loopTask", 8) != 0;
+
+  //claim the next free line, without locks as render, async and network tasks print
+  size_t position = head.load(std::memory_order_relaxed);
+  Line *line;
+  for (;;) {
+    line = &lines[position % PRINT_LINES];
+    const intptr_t diff = (intptr_t)line->sequence.load(std::memory_order_acquire) - (intptr_t)position;
+    if (diff == 0) {
+      if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) { //full: not drained yet
+      //boot (crash diagnostics) and the loop task (mapping bursts) wait for the output as before the ring buffer, UI only from the loop task
+      if ((!setupsDone || !asyncTask) && (to == 1 || !asyncTask) && drain(to, true))
+        position = head.load(std::memory_order_relaxed);
+      else {
+        droppedCounter++;
+        droppedUnreported++;
+        return;
+      }
+    } else
+      position = head.load(std::memory_order_relaxed);
+  }
 
+  va_list args;
   va_start(args, format);
+  const int length = vsnprintf(line->text, sizeof(line->text), format, args);
+  va_end(args);
 
-  char buffer[512]; //this is a lot for the stack - move to heap?
-  vsnprintf(buffer, sizeof(buffer), format, args);
-  bool toSerial = false;
-  
-  if (mdls->isConnected) {
-    uint8_t output = 1;
-    if (mdl->model)
-      output = mdl->getValue("Print", "output"); //"Print", 
-
-    if (output == 1) {
-      toSerial = true;
-    }
-    else if (output == 2) {
-      JsonObject responseObject = web->getResponseObject();
-      if (responseObject["Print.log"]["value"].isNull())
-        responseObject["Print.log"]["value"] = buffer;
-      else
-        responseObject["Print.log"]["value"] = responseObject["Print.log"]["value"].as<String>() + String(buffer);
-      // web->addResponse(variable.var, "value", JsonString(buffer)); //setValue not necessary
-      // variable.setValueF("%s", buffer);
-    }
-    else if (output == 3) {
-      //tbd
-    }
+  line->length = length < 0?0:min((size_t)length, sizeof(line->text) - 1);
+  if (length >= (int)sizeof(line->text) && format[strlen(format) - 1] == '\n')
+    line->text[line->length - 1] = '\n'; //truncated, keep the end of line
+  line->asyncTask = asyncTask;
+  line->sequence.store(position + 1, std::memory_order_release);
+
+  if (!printTaskHandle && to == 1) drain(1);
+}
+
+size_t SysModPrint::drain(uint8_t to, bool wait) {
+  if (to != target()) return 0; //Serial is drained by the print task, UI by the loop task
+  if (xSemaphoreTake(drainMutex, wait?portMAX_DELAY:0) != pdTRUE) return 0; //the other one drains
+
+  String uiText; //one response update per drain instead of per line
+  const size_t first = tail;
+  for (;;) {
+    Line &line = lines[tail % PRINT_LINES];
+    if (line.sequence.load(std::memory_order_acquire) != tail + 1) break; //empty or still being printed
+
+    if (to == 1) {
+      if (sys && sys->safeMode) Serial.print("🚑"); //print declared before sys
+      Serial.print(line.asyncTask?"α":""); //looptask λ/ asyncTCP task α
+      Serial.write((const uint8_t *)line.text, line.length);
+    } else
+      uiText += line.text;
+
+    linesCounter++;
+    bytesCounter += line.length;
+    line.sequence.store(tail + PRINT_LINES, std::memory_order_release); //free for the producers
+    tail++;
   }
-  else
-    toSerial = true;
+  const size_t drained = tail - first;
 
-  if (toSerial) {
-    if (sys && sys->safeMode) Serial.print("🚑"); //print declared before sys
-    Serial.print(strncmp(pcTaskGetTaskName(nullptr), "loopTask", 8) == 0?"":"α"); //looptask λ/ asyncTCP task α
-    Serial.print(buffer);
+  //in the log itself where the lines are missing, not only in the status
+  const unsigned long dropped = droppedUnreported.exchange(0);
+  if (dropped) {
+    char text[48];
+    const int length = snprintf(text, sizeof(text), "[%lu log lines dropped]\n", dropped);
+    if (to == 1)
+      Serial.write((const uint8_t *)text, length);
+    else
+      uiText += text;
   }
 
-  va_end(args);
+  xSemaphoreGive(drainMutex);
+
+  if (uiText.length()) {
+    JsonObject responseObject = web->getResponseObject();
+    if (responseObject["Print.log"]["value"].isNull())
+      responseObject["Print.log"]["value"] = uiText;
+    else
+      responseObject["Print.log"]["value"] = responseObject["Print.log"]["value"].as<String>() + uiText;
+  }
+
+  return drained;
 }
 
 void SysModPrint::println(const __FlashStringHelper * x) {
@@ -147,9 +263,13 @@ void SysModPrint::printVar(JsonObject var) {
 
 void SysModPrint::printJson(const char * text, JsonVariantConst source) {
   char resStr[1024];
-  serializeJson(source, resStr, sizeof(resStr));
+  size_t length = serializeJson(source, resStr, sizeof(resStr));
 
-  printf("%s %s\n", text, resStr);
+  //in parts as the lines of the log are PRINT_LINE_SIZE
+  printf("%s ", text);
+  for (size_t i = 0; i < length; i += PRINT_LINE_SIZE - 1)
+    printf("%.*s", PRINT_LINE_SIZE - 1, resStr + i);
+  printf("\n");
 }
 
 JsonString SysModPrint::fFormat(char * buf, size_t size, const char * format, ...) {
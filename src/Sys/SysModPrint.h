@@ -11,23 +11,86 @@
 
 #pragma once
 #include "SysModule.h"
+#include <atomic>
 
 #define ppf(x...) print->printf(x)
 // #define ppf(x...) //to have no print code compiled, difference is only 6308 bytes 
 // Flash: [======    ]  62.8% (used 1194250 bytes from 1900544 bytes)
 // Flash: [======    ]  63.2% (used 1200558 bytes from 1900544 bytes)
 
+//log levels: ppfE .. ppfV below STARBASE_LOG_LEVEL are not compiled (arguments not evaluated), the others print if print->logLevels[category] allows
+#define LOG_OFF 0
+#define LOG_ERROR 1
+#define LOG_WARN 2
+#define LOG_INFO 3
+#define LOG_DEBUG 4
+#define LOG_VERBOSE 5
+#ifndef STARBASE_LOG_LEVEL
+  #define STARBASE_LOG_LEVEL LOG_INFO
+#endif
+
+enum LogCategory {
+  lc_system,
+  lc_mapping,
+  lc_effects,
+  lc_json,
+  lc_network,
+  lc_live,
+  lc_count
+};
+
+#define ppfLevel(category, level, x...) do { if ((unsigned)(category) < lc_count && (level) <= print->logLevels[category]) print->printf(x); } while (0)
+#if STARBASE_LOG_LEVEL >= LOG_ERROR
+  #define ppfE(category, x...) ppfLevel(category, LOG_ERROR, x)
+#else
+  #define ppfE(category, x...)
+#endif
+#if STARBASE_LOG_LEVEL >= LOG_WARN
+  #define ppfW(category, x...) ppfLevel(category, LOG_WARN, x)
+#else
+  #define ppfW(category, x...)
+#endif
+#if STARBASE_LOG_LEVEL >= LOG_INFO
+  #define ppfI(category, x...) ppfLevel(category, LOG_INFO, x)
+#else
+  #define ppfI(category, x...)
+#endif
+#if STARBASE_LOG_LEVEL >= LOG_DEBUG
+  #define ppfD(category, x...) ppfLevel(category, LOG_DEBUG, x)
+#else
+  #define ppfD(category, x...)
+#endif
+#if STARBASE_LOG_LEVEL >= LOG_VERBOSE
+  #define ppfV(category, x...) ppfLevel(category, LOG_VERBOSE, x)
+#else
+  #define ppfV(category, x...)
+#endif
+
+#ifndef PRINT_LINES
+  #define PRINT_LINES 32 //log ring buffer: lines printed but not yet send to the output
+#endif
+#ifndef PRINT_LINE_SIZE
+  #define PRINT_LINE_SIZE 256 //longer lines are truncated
+#endif
+
 class SysModPrint:public SysModule {
 
 public:
 
+  uint8_t output = 1; //0: No, 1: Serial, 2: UI, cached as printf uses it for every line
+  uint8_t logLevels[lc_count]; //per LogCategory, up to STARBASE_LOG_LEVEL. Fixed size: read by ppfLevel from any task
+
   SysModPrint();
   void setup() override;
   void loop20ms() override;
 
-  //generic print function
+  //generic print function, adds the line to the log ring buffer in constant time from any task
   void printf(const char * format, ...);
 
+  //send the lines in the log ring buffer to output to if it is the output: Serial (print task) or UI (loop task)
+  //wait: for the other drainer instead of returning, returns the number of lines send
+  size_t drain(uint8_t to, bool wait = false);
+
   //not used yet
   void println(const __FlashStringHelper * x);
 
@@ -42,6 +105,27 @@ public:
 
 private:
   bool setupsDone = false;
+
+  //multi producer ring buffer, each line is free for a producer if its sequence is the producer position, and printed if it is the position + 1
+  struct Line {
+    std::atomic<size_t> sequence;
+    uint16_t length;
+    bool asyncTask;
+    char text[PRINT_LINE_SIZE];
+  };
+  Line lines[PRINT_LINES];
+  std::atomic<size_t> head{0}; //next line to print to
+  size_t tail = 0; //next line to drain, drainMutex taken
+  SemaphoreHandle_t drainMutex = xSemaphoreCreateMutex();
+  TaskHandle_t printTaskHandle = nullptr; //nullptr: no print task, printf drains
+
+  std::atomic<unsigned long> droppedCounter{0}; //per second, ring buffer full (only lines of async tasks after setup)
+  std::atomic<unsigned long> droppedUnreported{0}; //dropped since the last drain, reported in the log itself
+  unsigned long droppedTotal = 0;
+  unsigned long linesCounter = 0; //per second, drained
+  unsigned long bytesCounter = 0;
+
+  uint8_t target(); //the output, Serial as long as there is no UI
 };
 
 extern SysModPrint *print;
\ No newline at end of file
@@ -444,7 +444,8 @@ void SysModWeb::sendDataWs(std::function<void(AsyncWebSocketMessageBuffer *)> fi
   xSemaphoreGive(wsMutex);
 }
 
-void SysModWeb::sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, WebClient * client, bool lossless) {
+bool SysModWeb::sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, WebClient * client, bool lossless) {
+  bool sent = true;
   for (auto &loopClient:ws.getClients()) {
     if (!client || client == loopClient) {
       if (loopClient->status() == WS_CONNECTED && !loopClient->queueIsFull()) { //WS_MAX_QUEUED_MESSAGES / ws.count() / 2)) { //binary is lossy
@@ -456,16 +457,28 @@ void SysModWeb::sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, W
           else 
             sendWsTBytes+=wsBuf->length();
         }
-        else if (!lossless) ppf("sendBuffer not successful l:%d b:%d q:%d", wsBuf->length(), isBinary, loopClient->queueLen());
+        else {
+          if (!lossless) ppf("sendBuffer not successful l:%d b:%d q:%d", wsBuf->length(), isBinary, loopClient->queueLen());
+          sent = false;
+        }
       }
       else {
         printClient("sendDataWs client full or not connected", loopClient);
         // ppf("sendDataWs client full or not connected\n");
         ws.cleanupClients(); //only if above threshold
         ws._cleanBuffers();
+        sent = false;
       }
     }
   }
+  return sent;
+}
+
+size_t SysModWeb::maxQueueLen() {
+  size_t queueLen = 0;
+  for (auto &client:ws.getClients())
+    queueLen = max(queueLen, (size_t)client->queueLen());
+  return queueLen;
 }
 
 //add an url to the webserver to listen to
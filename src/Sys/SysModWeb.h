@@ -52,8 +52,8 @@ public:
   uint16_t sendWsBBytes = 0;
   uint8_t recvWsCounter = 0;
   uint16_t recvWsBytes = 0;
-  uint8_t sendUDPCounter = 0;
-  uint16_t sendUDPBytes = 0;
+  uint16_t sendUDPCounter = 0;
+  uint32_t sendUDPBytes = 0; //DDP / Art-Net send more then 64KB/s
   uint8_t recvUDPCounter = 0;
   uint16_t recvUDPBytes = 0;
 
@@ -78,7 +78,11 @@ public:
   //send json to client or all clients
   void sendDataWs(JsonVariant json = JsonVariant(), WebClient * client = nullptr);
   void sendDataWs(std::function<void(AsyncWebSocketMessageBuffer *)> fill, size_t len, bool isBinary, WebClient * client = nullptr);
-  void sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, WebClient * client = nullptr, bool lossless = true);
+  //returns false if not send to one or more of the clients
+  bool sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, WebClient * client = nullptr, bool lossless = true);
+
+  //longest send queue of the connected clients, to adapt send rates
+  size_t maxQueueLen();
 
   //add an url to the webserver to listen to
   void serveIndex(WebRequest *request);
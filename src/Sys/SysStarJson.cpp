@@ -18,10 +18,10 @@
 //ArduinoJson won't work on very large fixture.json, this does
 //only support what is currently needed: read / deserialize uint8/16/char var elements (arrays not yet)
   StarJson::StarJson(const char * path, const char * mode) {
-    // ppf("StarJson constructing %s %s\n", path, mode);
+    ppfD(lc_json, "StarJson constructing %s %s\n", path, mode);
     f = files->open(path, mode);
     if (!f)
-      ppf("StarJson open %s for %s failed", path, mode);
+      ppfE(lc_json, "StarJson open %s for %s failed\n", path, mode);
   }
 
   StarJson::~StarJson() {
@@ -61,7 +61,7 @@
   }
 
   //look for array of integers
-  void StarJson::lookFor(const char * id, const std::function<void(std::vector<uint16_t>)>& fun) {
+  void StarJson::lookFor(const char * id, const std::function<void(const std::vector<uint16_t> &)>& fun) {
     funList.push_back(fun);
     addToVars(id, "fun", funList.size()-1);
   }
@@ -69,13 +69,13 @@
   //reads from file until all vars have been found (then stops reading)
   //returns false if not all vars to look for are found
   bool StarJson::deserialize(const bool lazy) {
-    f.read(&character, sizeof(byte));
-    while (f.available() && (!foundAll || !lazy))
+    readCharacter();
+    while (!eof && (!foundAll || !lazy))
       next();
     if (foundAll)
-      ppf("StarJson found all what it was looking for %d >= %d\n", foundCounter, varDetails.size());
+      ppfI(lc_json, "StarJson found all what it was looking for %d >= %d\n", foundCounter, varDetails.size());
     else
-      ppf("StarJson Not all vars looked for where found %d < %d\n", foundCounter, varDetails.size());
+      ppfW(lc_json, "StarJson Not all vars looked for where found %d < %d\n", foundCounter, varDetails.size());
     f.close();
     return foundAll;
   }
@@ -89,27 +89,51 @@
     varDetails.push_back(vd);
   }
 
+  bool StarJson::readCharacter() {
+    if (bufferPos >= bufferLen) {
+      bufferLen = f?f.read(buffer, sizeof(buffer)):0;
+      bufferPos = 0;
+      if (bufferLen == 0) {
+        eof = true;
+        character = 0;
+        return false;
+      }
+    }
+    character = buffer[bufferPos++];
+    return true;
+  }
+
+  void StarJson::pushVar(const char * varId) {
+    if (varStackSize < STARJSON_STACK_DEPTH)
+      strlcpy(varStack[varStackSize], varId, STARJSON_ID_LENGTH);
+    varStackSize++;
+  }
+
+  const char * StarJson::varFromTop(size_t depth) {
+    if (depth >= varStackSize) return "";
+    size_t index = varStackSize - 1 - depth;
+    return index < STARJSON_STACK_DEPTH?varStack[index]:"";
+  }
+
   void StarJson::next() {
     if (character=='{') { //object begin
-      // ppf("Object %c\n", character);
-      varStack.push_back(lastVarId); //copy!!
-      // ppf("Object push %s %d\n", lastVarId, varStack.size());
+      pushVar(lastVarId); //copy!!
+      ppfV(lc_json, "Object push %s %d\n", lastVarId, varStackSize);
       strlcpy(lastVarId, "", sizeof(lastVarId));
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else if (character=='}') { //object end
-      strlcpy(lastVarId, varStack[varStack.size()-1].c_str(), sizeof(lastVarId));
-      // ppf("Object pop %s %d\n", lastVarId, varStack.size());
+      strlcpy(lastVarId, varFromTop(0), sizeof(lastVarId));
+      ppfV(lc_json, "Object pop %s %d\n", lastVarId, varStackSize);
       check(lastVarId);
-      varStack.pop_back();
-      f.read(&character, sizeof(byte));
+      if (varStackSize) varStackSize--;
+      readCharacter();
     }
     else if (character=='[') { //array begin
-      // ppf("Array %c\n", character);
-      varStack.push_back(lastVarId); //copy!!
-      // ppf("Array push %s %d\n", lastVarId, varStack.size());
+      pushVar(lastVarId); //copy!!
+      ppfV(lc_json, "Array push %s %d\n", lastVarId, varStackSize);
       strlcpy(lastVarId, "", sizeof(lastVarId));
-      f.read(&character, sizeof(byte));
+      readCharacter();
 
       //now we want to collect the array elements
       collectNumbers = true;
@@ -117,52 +141,57 @@
     }
     else if (character==']') { //array end
       //assign back the popped var id from [
-      strlcpy(lastVarId, varStack[varStack.size()-1].c_str(), sizeof(lastVarId));
-      // ppf("Array pop %s %d %d\n", lastVarId, varStack.size(), uint16CollectList.size());
+      strlcpy(lastVarId, varFromTop(0), sizeof(lastVarId));
+      ppfV(lc_json, "Array pop %s %d %d\n", lastVarId, varStackSize, uint16CollectList.size());
       check(lastVarId);
 
       //check the parent array, if exists
-      if (varStack.size() - 2 >= 0) {
-        // ppf("  Parent check %s\n", varStack[varStack.size()-2].c_str());
-        strlcpy(beforeLastVarId, varStack[varStack.size()-2].c_str(), sizeof(beforeLastVarId));
+      if (varStackSize >= 2) {
+        ppfV(lc_json, "  Parent check %s\n", varFromTop(1));
+        strlcpy(beforeLastVarId, varFromTop(1), sizeof(beforeLastVarId));
         check(beforeLastVarId);
       }
-      varStack.pop_back(); //remove var id of this array
+      if (varStackSize) varStackSize--; //remove var id of this array
       collectNumbers = false;
       uint16CollectList.clear();
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else if (character=='"') { //parse String
       char value[128] = "";
-      f.readBytesUntil('"', value, sizeof(value)-1);
+      size_t len = 0;
+      while (readCharacter() && character != '"') {
+        if (len < sizeof(value)-1)
+          value[len++] = character;
+      }
+      value[len] = '\0';
     
       //if no lastVar then var found
       if (strncmp(lastVarId, "", sizeof(lastVarId)) == 0) {
-        // ppf("Element [%s]\n", value);
+        ppfV(lc_json, "Element [%s]\n", value);
         strlcpy(lastVarId, value, sizeof(lastVarId));
       }
       else { // if lastvar then string value found
-        // ppf("String var %s: [%s]\n", lastVarId, value);
+        ppfV(lc_json, "String var %s: [%s]\n", lastVarId, value);
         check(lastVarId, value);
         strlcpy(lastVarId, "", sizeof(lastVarId));
       }
 
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else if (isDigit(character)) { //parse number
       char value[100] = "";
 
       size_t len = 0;
       //readuntil not number
-      while (isDigit(character)) {
+      while (isDigit(character) && len < sizeof(value)-1) {
         // ppf("%c", character);
         value[len++] = character;
-        f.read(&character, sizeof(byte));
+        readCharacter();
       }
       value[len++] = '\0';
 
       //number value found
-      // ppf("Number var %s: [%s]\n", lastVarId, value);
+      ppfV(lc_json, "Number var %s: [%s]\n", lastVarId, value);
       if (collectNumbers)
         uint16CollectList.push_back(strtol(value, nullptr, 10));
 
@@ -172,27 +201,27 @@
     }
     else if (character==':') {
       // ppf("semicolon %c\n", character);
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else if (character==',') {
       // ppf("sep %c\n", character);
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else if (character==']') {
       // ppf("close %c\n", character);
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else if (character=='}') {
       // ppf("close %c\n", character);
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else if (character=='\n') { //skip new lines
       // ppf("skip newline \n");
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
     else {
       // ppf("%c", character);
-      f.read(&character, sizeof(byte));
+      readCharacter();
     }
   } //next
 
@@ -201,7 +230,7 @@
     for (std::vector<VarDetails>::iterator vd=varDetails.begin(); vd!=varDetails.end(); ++vd) {
       // ppf("check %s %s %s\n", vd->id, varId, value);
       if (strncmp(vd->id, varId, 32)==0) {
-        // ppf("StarJson found %s:%s %d %s %d %d\n", varId, vd->type, vd->index, value?value:"", uint16CollectList.size(), funList.size());
+        ppfV(lc_json, "StarJson found %s:%s %d %s %d %d\n", varId, vd->type, vd->index, value?value:"", uint16CollectList.size(), funList.size());
         if (strncmp(vd->type, "uint8", 7) ==0 && value) *uint8List[vd->index] = strtol(value, nullptr, 10);
         // if (strncmp(vd->type, "uint16", 7) ==0 && value) *uint16List[vd->index] = strtol(value, nullptr, 10);
         // if (strncmp(vd->type, "int", 7) ==0 && value) *intList[vd->index] = strtol(value, nullptr, 10);
@@ -259,5 +288,5 @@
       f.print("null");      
     }
     else
-      ppf("dev StarJson write %s not supported\n", variant.as<String>().c_str());
+      ppfE(lc_json, "dev StarJson write %s not supported\n", variant.as<String>().c_str());
   }
@@ -15,6 +15,10 @@
 
 #include <vector>
 
+#define STARJSON_BUFFER_SIZE 512 //file is read in chunks of this size
+#define STARJSON_STACK_DEPTH 8 //max nesting of objects and arrays with remembered var ids (deeper is parsed but ids are not remembered)
+#define STARJSON_ID_LENGTH 32 //var ids are compared up to this length
+
 //Lazy Json Read Deserialize Write Serialize (write / serialize not implemented yet)
 //ArduinoJson won't work on very large fixture.json, this does
 //only support what is currently needed: read / deserialize uint8/16/char var elements (arrays not yet)
@@ -42,7 +46,7 @@ class StarJson {
   // void lookFor(const char * id, uint16_t * value);
   // void lookFor(const char * id, int * value);
   void lookFor(const char * id, char * value);
-  void lookFor(const char * id, const std::function<void(std::vector<uint16_t>)>& fun);
+  void lookFor(const char * id, const std::function<void(const std::vector<uint16_t> &)>& fun);
 
   //reads from file until all vars have been found (then stops reading)
   //returns false if not all vars to look for are found
@@ -57,13 +61,18 @@ private:
 
   File f;
   byte character; //the last character parsed
+  uint8_t buffer[STARJSON_BUFFER_SIZE]; //characters read from f, not parsed yet
+  size_t bufferPos = 0;
+  size_t bufferLen = 0;
+  bool eof = false;
   std::vector<VarDetails> varDetails; //details of vars looking for
   std::vector<uint8_t *> uint8List; //pointer of uint8 to assign found values to (index of list stored in varDetails)
   // std::vector<uint16_t *> uint16List; //same for uint16
   // std::vector<int *> intList; //same for int
   std::vector<char *> charList; //same for char
-  std::vector<std::function<void(std::vector<uint16_t>)>> funList; //same for function calls
-  std::vector<String> varStack; //objects and arrays store their names in a stack
+  std::vector<std::function<void(const std::vector<uint16_t> &)>> funList; //same for function calls
+  char varStack[STARJSON_STACK_DEPTH][STARJSON_ID_LENGTH]; //objects and arrays store their names in a stack
+  size_t varStackSize = 0; //can be more then STARJSON_STACK_DEPTH, then the ids are not stored
   bool collectNumbers = false; //array can ask to store all numbers found in array (now used for x,y,z coordinates)
   std::vector<uint16_t> uint16CollectList; //collected numbers
   char lastVarId[128] = ""; //last found var id in json
@@ -74,6 +83,12 @@ private:
   //called by lookedFor, store the var details in varDetails
   void addToVars(const char * id, const char * type, size_t index);
 
+  //next character from the buffer, refill the buffer from f if empty. false (and character 0) at end of file
+  bool readCharacter();
+
+  void pushVar(const char * varId);
+  const char * varFromTop(size_t depth); //0 is top, "" if not stored
+
   void next();
 
   void check(char * varId, char * value = nullptr);
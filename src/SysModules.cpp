@@ -113,6 +113,14 @@ void SysModules::setup() {
 
 }
 
+#define STARBASE_DEADLINE_MARGIN 2000 //µs before deadlineMicros the periodic loops wait
+#define STARBASE_DEADLINE_WAIT 20 //ms a periodic loop waits at most
+
+//a periodic loop is due after its period, if a deadline is near it waits until after the deadline (but not more then STARBASE_DEADLINE_WAIT)
+static inline bool periodDue(unsigned long elapsed, unsigned long period, bool deadlineNear) {
+  return elapsed >= period && (!deadlineNear || elapsed >= period + STARBASE_DEADLINE_WAIT);
+}
+
 void SysModules::loop() {
   // bool oneSec = false;
   // bool tenSec = false;
@@ -129,15 +137,16 @@ void SysModules::loop() {
       uint32_t cycles = ESP.getCycleCount();
       module->loop();
       // (module->*module->loopCached)(); //use virtual cached function for speed??? tested, no difference ...
-      if (millis() - module->twentyMsMillis >= 20) {
+      const bool deadlineNear = deadlineMicros && (long)(deadlineMicros - micros()) < STARBASE_DEADLINE_MARGIN;
+      if (periodDue(millis() - module->twentyMsMillis, 20, deadlineNear)) {
         module->twentyMsMillis = millis();
         module->loop20ms(); //use virtual cached function for speed???
       }
-      if (millis() - module->oneSecondMillis >= 1000) {
+      if (periodDue(millis() - module->oneSecondMillis, 1000, deadlineNear)) {
         module->oneSecondMillis = millis();
         module->loop1s();
       }
-      if (millis() - module->tenSecondMillis >= 10000) {
+      if (periodDue(millis() - module->tenSecondMillis, 10000, deadlineNear)) {
         module->tenSecondMillis = millis();
         module->loop10s();
       }
@@ -18,6 +18,9 @@ public:
   bool isConnected = false;
   uint32_t buttonPressedTime = 0;
 
+  //set by a module which has to run in time (e.g. the next frame), the 20ms, 1s and 10s loops of modules wait if it is near
+  unsigned long deadlineMicros = 0; //0: no deadline
+
   SysModules();
 
   void setup();
@@ -9,18 +9,125 @@
    @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
 */
 
+#include <AsyncUDP.h>
+
 #define ARTNET_DEFAULT_PORT 6454
+#define ARTNET_HEADER_SIZE 18 // ArtDmx: id, opcode, version, sequence, physical, port address, length
+#define ARTNET_SYNC_SIZE 14
+#define ARTNET_MAX_CHANNELS 512
+
+//a universe of an output: which channels of the leds go to which port address of which node
+struct ArtNetUniverse {
+  size_t channel; //first channel in the leds (led * 3)
+  uint16_t channels; //nr of channels of the leds in the packet
+  uint16_t portAddress; //net (7 bits) << 8 | subnet (4 bits) << 4 | universe (4 bits)
+  uint8_t node; //ip[3] of the node
+  size_t packetOffset = 0; //of the preallocated packet
+  uint16_t length() const {return channels + (channels & 1);} //ArtDmx length is even
+};
+
+//add the universes of nrOfLeds leds from startLed on, from portAddress on, 510 (170 leds, no led split over universes) or 512 channels per universe
+inline void artnetAddOutput(std::vector<ArtNetUniverse> &universes, size_t startLed, size_t nrOfLeds, uint16_t portAddress, uint8_t node, bool pack512) {
+  const size_t channelsPerUniverse = pack512?ARTNET_MAX_CHANNELS:510;
+  const size_t endChannel = (startLed + nrOfLeds) * sizeof(CRGB);
+  for (size_t channel = startLed * sizeof(CRGB); channel < endChannel; channel += channelsPerUniverse) {
+    ArtNetUniverse universe;
+    universe.channel = channel;
+    universe.channels = min(channelsPerUniverse, endChannel - channel);
+    universe.portAddress = portAddress++ & 0x7FFF;
+    universe.node = node;
+    universes.push_back(universe);
+  }
+}
+
+//the part of an ArtDmx packet which does not change per frame
+inline void artnetHeader(uint8_t *packet, const ArtNetUniverse &universe) {
+  memcpy(packet, "Art-Net", 8); //including \0
+  packet[8] = 0x00; packet[9] = 0x50; //OpDmx 0x5000, low byte first
+  packet[10] = 0; packet[11] = 14; //protocol version
+  packet[12] = 0; //sequence, per frame
+  packet[13] = 0; //physical
+  packet[14] = universe.portAddress; //SubUni
+  packet[15] = universe.portAddress >> 8; //Net
+  packet[16] = universe.length() >> 8;
+  packet[17] = universe.length();
+}
+
+//the per frame part of an ArtDmx packet: the channels of the universe through lut of the channel (r,g,b), 0 if not in leds (nrOfChannels), returns the length of the packet
+inline size_t artnetData(uint8_t *packet, const CRGB *leds, size_t nrOfChannels, const ArtNetUniverse &universe, uint8_t sequenceNumber, const uint8_t lut[3][256]) {
+  packet[12] = sequenceNumber;
+
+  const uint8_t *source = &leds[0].r + universe.channel; //leds is a continuous array of r,g,b bytes
+  uint8_t *data = packet + ARTNET_HEADER_SIZE;
+  const size_t available = universe.channel < nrOfChannels?min((size_t)universe.channels, nrOfChannels - universe.channel):0;
+  uint8_t rgb = universe.channel % 3;
+  for (size_t i = 0; i < available; i++) {
+    data[i] = lut[rgb][source[i]];
+    if (++rgb == 3) rgb = 0;
+  }
+  memset(data + available, 0, universe.length() - available);
+
+  return ARTNET_HEADER_SIZE + universe.length();
+}
+
+//a node receiving universes, sends at most maxFps
+struct ArtNetNode {
+  uint8_t ip; //ip[3]
+  unsigned long lastMillis = 0;
+  bool send = false; //this frame
+};
+
+//the packets of universes with the headers filled in (packetOffset per universe) and the nodes they are send to
+inline void artnetMakePackets(std::vector<ArtNetUniverse> &universes, std::vector<uint8_t> &packets, std::vector<ArtNetNode> &nodes) {
+  nodes.clear();
+  size_t packetSize = 0;
+  for (ArtNetUniverse &universe: universes) {
+    universe.packetOffset = packetSize;
+    packetSize += ARTNET_HEADER_SIZE + universe.length();
+    bool found = false;
+    for (ArtNetNode &node: nodes) found |= node.ip == universe.node;
+    if (!found) nodes.push_back({universe.node});
+  }
 
-const size_t ART_NET_HEADER_SIZE = 12;
-const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+  packets.resize(packetSize);
+  packets.shrink_to_fit();
+  for (const ArtNetUniverse &universe: universes)
+    artnetHeader(packets.data() + universe.packetOffset, universe);
+}
+
+//rate limit per node: set send of the nodes due at now, maxFps 0: no limit, returns true if any node is send to
+inline bool artnetNodesDue(std::vector<ArtNetNode> &nodes, unsigned long now, uint16_t maxFps) {
+  bool send = false;
+  const unsigned long period = maxFps?1000 / maxFps:0;
+  for (ArtNetNode &node: nodes) {
+    const unsigned long elapsed = now - node.lastMillis;
+    node.send = node.ip && elapsed >= period;
+    if (node.send) node.lastMillis = elapsed < 2 * period?node.lastMillis + period:now; //keep the pace: frames slightly faster than maxFps are not halved
+    send |= node.send;
+  }
+  return send;
+}
+
+//ArtSync: the nodes show the data received since the previous ArtSync, all universes at once
+inline size_t artsyncPacket(uint8_t *packet) {
+  memcpy(packet, "Art-Net", 8);
+  packet[8] = 0x00; packet[9] = 0x52; //OpSync 0x5200, low byte first
+  packet[10] = 0; packet[11] = 14; //protocol version
+  packet[12] = 0; packet[13] = 0; //aux
+  return ARTNET_SYNC_SIZE;
+}
 
 class UserModArtNet:public SysModule {
 
 public:
 
   IPAddress targetIp; //tbd: targetip also configurable from fixtures and artnet instead of pin output
-  std::vector<uint16_t> hardware_outputs = {1024,1024,1024,1024,1024,1024,1024,1024};
-  std::vector<uint16_t> hardware_outputs_universe_start = { 0,7,14,21,28,35,42,49 }; //7*170 = 1190 leds => last universe not completely used
+  std::vector<uint16_t> outputStart = {0,1024,2048,3072,4096,5120,6144,7168}; //first led
+  std::vector<uint16_t> outputSize = {1024,1024,1024,1024,1024,1024,1024,1024};
+  std::vector<uint16_t> outputUniverse = { 0,7,14,21,28,35,42,49 }; //7*170 = 1190 leds => last universe not completely used
+  std::vector<uint16_t> outputNode = {0,0,0,0,0,0,0,0}; //ip[3], 0: targetIP
+  bool3State pack512 = false;
+  uint16_t maxFps = 44; //per node, 0: no limit
 
   UserModArtNet() :SysModule("ArtNet") {
     isEnabled = false; //default off
@@ -39,114 +146,162 @@ public:
       case onChange: {
         uint8_t value = variable.value();
         targetIp[3] = value;
+        doMakeUniverses = true;
         return true; }
       default: return false;
     }});
 
+    ui->initCheckBox(parentVar, "pack512", &pack512, false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("512 channels per universe, else 510 (170 leds, no led split over universes)");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
+      default: return false;
+    }});
+
+    ui->initNumber(parentVar, "maxFps", &maxFps, 0, 999, false, [](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("Per node, 0: no limit");
+        return true;
+      default: return false;
+    }});
+
+    Variable currentVar = ui->initText(parentVar, "status", nullptr, 64, true);
+    currentVar.setComment("Per second, send time per frame");
+    currentVar.subscribe(onLoop1s, [this](EventArguments) {
+      variable.setValueF("%lu packets %lu KB %lu µs", packetCounter, byteCounter / 1024, sendMicros);
+      packetCounter = 0;
+      byteCounter = 0;
+    });
+
     Variable tableVar = ui->initTable(parentVar, "outputs");
 
-    ui->initNumber(tableVar, "start", &hardware_outputs_universe_start, 0, UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
+    ui->initNumber(tableVar, "led", &outputStart, 0, UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
       case onUI:
-        variable.setComment("Start universe");
+        variable.setComment("First led");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
         return true;
       default: return false;
     }});
-    ui->initNumber(tableVar, "size", &hardware_outputs, 0, UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
+    ui->initNumber(tableVar, "size", &outputSize, 0, UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
       case onUI:
         variable.setComment("# pixels");
         return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
       default: return false;
     }});
+    ui->initNumber(tableVar, "start", &outputUniverse, 0, 0x7FFF, false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("Start universe: net * 256 + subnet * 16 + universe");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
+      default: return false;
+    }});
+    ui->initNumber(tableVar, "node", &outputNode, 0, 255, false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("IP, 0: targetIP");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
+      default: return false;
+    }});
+  }
+
+  //universes of all outputs and their packets with the headers filled in, called if the outputs changed
+  void makeUniverses() {
+    universes.clear();
+    for (size_t output = 0; output < outputSize.size(); output++) {
+      size_t startLed = output < outputStart.size()?outputStart[output]:0;
+      uint16_t portAddress = output < outputUniverse.size()?outputUniverse[output]:0;
+      uint8_t node = (output < outputNode.size() && outputNode[output])?outputNode[output]:targetIp[3];
+      artnetAddOutput(universes, startLed, outputSize[output], portAddress, node, pack512);
+    }
+
+    artnetMakePackets(universes, packets, nodes);
 
+    ppf("ArtNet universes:%d nodes:%d packets:%d B\n", universes.size(), nodes.size(), packets.size());
+    doMakeUniverses = false;
   }
 
-  void loop20ms() override {
+  void loop() override {
     // SysModule::loop();
 
     if(!mdls->isConnected) return;
 
-    targetIp[0] = net->localIP()[0];
-    targetIp[1] = net->localIP()[1];
-    targetIp[2] = net->localIP()[2];
-
-    if(!targetIp) return;
-
     if(!eff->newFrame) return;
 
-    uint8_t bri = mdl->linearToLogarithm(fix->bri);
-
-    // calculate the number of UDP packets we need to send
-
-    byte packet_buffer[ART_NET_HEADER_SIZE + 6 + 512];
-    memcpy(packet_buffer, ART_NET_HEADER, 12); // copy in the Art-Net header.
-
-    AsyncUDP artnetudp;// AsyncUDP so we can just blast packets.
-
-    uint_fast16_t bufferOffset = 0;
-    uint_fast16_t hardware_output_universe = 0;
-    
-    sequenceNumber++;
-
-    if (sequenceNumber == 0) sequenceNumber = 1; // just in case, as 0 is considered "Sequence not in use"
-    if (sequenceNumber > 255) sequenceNumber = 1;
-    
-    for (uint_fast16_t hardware_output = 0; hardware_output < hardware_outputs.size(); hardware_output++) { //loop over all outputs
-      
-      if (bufferOffset > fix->nrOfLeds * sizeof(CRGB)) {
-        // This stop is reached if we don't have enough pixels for the defined Art-Net output.
-        return; // stop when we hit end of LEDs
-      }
+    if (doMakeUniverses) makeUniverses();
 
-      hardware_output_universe = hardware_outputs_universe_start[hardware_output];
+    IPAddress ip = net->localIP();
+    if (!ip) return;
 
-      uint_fast16_t channels_remaining = hardware_outputs[hardware_output] * sizeof(CRGB);
+    unsigned long start = micros();
 
-      while (channels_remaining > 0) {
-        const uint_fast16_t ARTNET_CHANNELS_PER_PACKET = 510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+    if (!artnetNodesDue(nodes, sys->now, maxFps)) return;
 
-        uint_fast16_t packetSize = ARTNET_CHANNELS_PER_PACKET;
+    sequenceNumber = sequenceNumber % 255 + 1; // 1..255, 0 is sequence not used
 
-        if (channels_remaining < ARTNET_CHANNELS_PER_PACKET) {
-          packetSize = channels_remaining;
-          channels_remaining = 0;
-        } else {
-          channels_remaining -= packetSize;
-        }
+    const size_t nrOfChannels = min(fix->nrOfLeds, fix->ledsPSize) * sizeof(CRGB); //ledsPSize: less if allocation failed
 
-        // set the parts of the Art-Net packet header that change:
-        packet_buffer[12] = sequenceNumber;
-        packet_buffer[14] = hardware_output_universe;
-        packet_buffer[16] = packetSize >> 8;
-        packet_buffer[17] = packetSize;
+    for (const ArtNetUniverse &universe: universes) {
+      if (!nodeOf(universe.node).send) continue;
 
-        // bulk copy the buffer range to the packet buffer after the header 
-        memcpy(packet_buffer+18, (&fix->ledsP[0].r)+bufferOffset, packetSize); //start from the first byte of ledsP[0]
+      uint8_t *packet = packets.data() + universe.packetOffset;
+      size_t packetLength = artnetData(packet, fix->ledsP, nrOfChannels, universe, sequenceNumber, fix->outputLut);
 
-        for (int i = 18; i < packetSize+18; i+=sizeof(CRGB)) {
-          // set brightness all at once - seems slightly faster than scale8()?
-          // for some reason, doing 3/4 at a time is 200 micros faster than 1 at a time.
-          packet_buffer[i] = (packet_buffer[i] * bri) >> 8;
-          packet_buffer[i+1] = (packet_buffer[i+1] * bri) >> 8;
-          packet_buffer[i+2] = (packet_buffer[i+2] * bri) >> 8; 
-        }
-
-        bufferOffset += packetSize;
-        
-        if (!artnetudp.writeTo(packet_buffer, packetSize+18, targetIp, ARTNET_DEFAULT_PORT)) {
-          ppf("🐛");
-          return; // borked
-        }
+      ip[3] = universe.node;
+      if (!artnetUdp.writeTo(packet, packetLength, ip, ARTNET_DEFAULT_PORT)) {
+        ppf("🐛");
+        return; // borked
+      }
 
-        web->sendUDPCounter++;
-        web->sendUDPBytes+=packetSize+18;
+      packetCounter++;
+      byteCounter += packetLength;
+      web->sendUDPCounter++;
+      web->sendUDPBytes += packetLength;
+    }
 
-        hardware_output_universe++;
-      }
+    //after the frame: the nodes show it at once
+    uint8_t syncPacket[ARTNET_SYNC_SIZE];
+    size_t syncLength = artsyncPacket(syncPacket);
+    for (const ArtNetNode &node: nodes) {
+      if (!node.send) continue;
+      ip[3] = node.ip;
+      artnetUdp.writeTo(syncPacket, syncLength, ip, ARTNET_DEFAULT_PORT);
+      packetCounter++;
+      byteCounter += syncLength;
     }
+
+    sendMicros = micros() - start;
   } //loop
 
   private:
-    size_t sequenceNumber = 0;
+    std::vector<ArtNetUniverse> universes;
+    std::vector<ArtNetNode> nodes;
+    std::vector<uint8_t> packets; //per universe header and data, preallocated by makeUniverses
+    bool doMakeUniverses = true;
+
+    AsyncUDP artnetUdp; // AsyncUDP so we can just blast packets.
+    uint8_t sequenceNumber = 0;
+
+    unsigned long packetCounter = 0; //per second
+    unsigned long byteCounter = 0; //per second
+    unsigned long sendMicros = 0; //last frame
+
+    ArtNetNode &nodeOf(uint8_t ip) {
+      for (ArtNetNode &node: nodes)
+        if (node.ip == ip) return node;
+      return nodes.front(); //every universe has a node
+    }
 
 };
 
@@ -9,6 +9,8 @@
    @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
 */
 
+#include <AsyncUDP.h>
+
 #define DDP_DEFAULT_PORT 4048
 #define DDP_HEADER_LEN 10
 #define DDP_SYNCPACKET_LEN 10
@@ -31,6 +33,37 @@
 #define DDP_TYPE_RGB24  0x0B // 00 001 011 (RGB , 8 bits per channel, 3 channels)
 #define DDP_TYPE_RGBW32 0x1B // 00 011 011 (RGBW, 8 bits per channel, 4 channels)
 
+//build packet packetNr of the DDP frame for leds in packet (DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET bytes), returns the length of the packet
+//each packet contains the channels from its offset on, the last packet has the push flag, lut of the channel (r,g,b) is applied to each channel
+inline size_t ddpPacket(uint8_t *packet, const CRGB *leds, size_t nrOfLeds, size_t packetNr, uint8_t sequenceNumber, const uint8_t lut[3][256]) {
+  const size_t channelCount = nrOfLeds * sizeof(CRGB); // 1 channel for every R,G,B value
+  const uint32_t channel = packetNr * DDP_CHANNELS_PER_PACKET;
+  const size_t packetSize = min(channelCount - channel, (size_t)DDP_CHANNELS_PER_PACKET); // the amount of data AFTER the header
+
+  /*0*/packet[0] = (channel + packetSize >= channelCount)?DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH:DDP_FLAGS1_VER1;
+  /*1*/packet[1] = sequenceNumber & 0x0F;
+  /*2*/packet[2] = DDP_TYPE_RGB24;
+  /*3*/packet[3] = DDP_ID_DISPLAY;
+  // data offset in bytes, 32-bit number, MSB first
+  /*4*/packet[4] = channel >> 24;
+  /*5*/packet[5] = channel >> 16;
+  /*6*/packet[6] = channel >> 8;
+  /*7*/packet[7] = channel;
+  // data length in bytes, 16-bit number, MSB first
+  /*8*/packet[8] = packetSize >> 8;
+  /*9*/packet[9] = packetSize;
+
+  const uint8_t *source = &leds[0].r + channel; //leds is a continuous array of r,g,b bytes
+  uint8_t *data = packet + DDP_HEADER_LEN;
+  uint8_t rgb = channel % 3; //DDP_CHANNELS_PER_PACKET is a multiple of 3 so always 0
+  for (size_t i = 0; i < packetSize; i++) {
+    data[i] = lut[rgb][source[i]];
+    if (++rgb == 3) rgb = 0;
+  }
+
+  return DDP_HEADER_LEN + packetSize;
+}
+
 class UserModDDP:public SysModule {
 
 public:
@@ -90,77 +123,29 @@ public:
     if(!eff->newFrame) return;
 
     // calculate the number of UDP packets we need to send
-    bool isRGBW = false;
-    uint8_t bri = mdl->linearToLogarithm(fix->bri);
-
-    const size_t channelCount = fix->nrOfLeds * (isRGBW? 4:3); // 1 channel for every R,G,B,(W?) value
-    const size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
+    const size_t nrOfLeds = min(fix->nrOfLeds, fix->ledsPSize); //ledsPSize: less if allocation failed
+    const size_t channelCount = nrOfLeds * sizeof(CRGB);
+    const size_t packetCount = (channelCount + DDP_CHANNELS_PER_PACKET - 1) / DDP_CHANNELS_PER_PACKET;
 
-    uint32_t channel = 0; 
-    size_t bufferOffset = 0;
+    AsyncUDP ddpUdp; // AsyncUDP so we can just blast packets.
 
-    sequenceNumber++;
+    for (size_t packetNr = 0; packetNr < packetCount; packetNr++) {
+      size_t packetLength = ddpPacket(packet, fix->ledsP, nrOfLeds, packetNr, sequenceNumber, fix->outputLut);
+      sequenceNumber = sequenceNumber % 15 + 1; // 1..15, 0 is sequence not used
 
-    WiFiUDP ddpUdp;
-
-    for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-      if (sequenceNumber > 15) sequenceNumber = 0;
-
-      if (!ddpUdp.beginPacket(targetIp, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-        ppf("DDP WiFiUDP.beginPacket returned an error\n");
+      if (!ddpUdp.writeTo(packet, packetLength, targetIp, DDP_DEFAULT_PORT)) {
+        ppf("DDP AsyncUDP.writeTo returned an error\n");
         return; // borked
       }
 
-      // the amount of data is AFTER the header in the current packet
-      size_t packetSize = DDP_CHANNELS_PER_PACKET;
-
-      byte flags = DDP_FLAGS1_VER1;
-      if (currentPacket == (packetCount - 1U)) {
-        // last packet, set the push flag
-        // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
-        flags = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
-        if (channelCount % DDP_CHANNELS_PER_PACKET) {
-          packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
-        }
-      }
-
-      // write the header
-      /*0*/ddpUdp.write(flags);
-      /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-      /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-      /*3*/ddpUdp.write(DDP_ID_DISPLAY);
-      // data offset in bytes, 32-bit number, MSB first
-      /*4*/ddpUdp.write(0xFF & (channel >> 24));
-      /*5*/ddpUdp.write(0xFF & (channel >> 16));
-      /*6*/ddpUdp.write(0xFF & (channel >>  8));
-      /*7*/ddpUdp.write(0xFF & (channel      ));
-      // data length in bytes, 16-bit number, MSB first
-      /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-      /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-      for (size_t i = 0; i < fix->nrOfLeds; i++) {
-        CRGB pixel = fix->ledsP[i];
-        ddpUdp.write(scale8(pixel.r, bri)); // R
-        ddpUdp.write(scale8(pixel.g, bri)); // G
-        ddpUdp.write(scale8(pixel.b, bri)); // B
-        // if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], fix->bri)); // W
-      }
-
-      if (!ddpUdp.endPacket()) {
-        ppf("DDP WiFiUDP.endPacket returned an error\n");
-        return; // problem
-      }
-
       web->sendUDPCounter++;
-      web->sendUDPBytes+=packetSize;
-
-      channel += packetSize;
+      web->sendUDPBytes += packetLength;
     }
   }
 
   private:
-    size_t sequenceNumber = 0;
+    uint8_t sequenceNumber = 1;
+    uint8_t packet[DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET];
 
 };
 
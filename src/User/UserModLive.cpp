@@ -38,7 +38,7 @@ Parser parser = Parser();
 
  void UserModLive::preKill()
 {
-  ppf("ELS preKill\n");
+  ppfD(lc_live, "ELS preKill\n");
   // LEDS specific
   //tbd: move this to LedModFixture...
   #if STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
@@ -49,7 +49,7 @@ Parser parser = Parser();
 }
  void UserModLive::postKill()
 {
-  ppf("ELS postKill\n");
+  ppfD(lc_live, "ELS postKill\n");
   // LEDS specific
   #if STARLIGHT_PHYSICAL_DRIVER || STARLIGHT_VIRTUAL_DRIVER
     // delay(10);
@@ -113,7 +113,7 @@ static float _time(float j) {
           if (exeID != UINT8_MAX)
             liveM->executeBackgroundTask(exeID);
           else 
-            ppf("mapInitAlloc task not created (compilation error?) %s\n", fileName);
+            ppfE(lc_live, "mapInitAlloc task not created (compilation error?) %s\n", fileName);
         }
         else {
           // kill();
@@ -239,7 +239,7 @@ static float _time(float j) {
         if (rowNr < scriptRuntime._scExecutables.size())
           killAndDelete(scriptRuntime._scExecutables[rowNr].name.c_str());
         else
-          ppf("dev try to kill a script which does not exist anymore... (%d)\n", rowNr);
+          ppfE(lc_live, "dev try to kill a script which does not exist anymore... (%d)\n", rowNr);
         return true;
       default: return false;
     }});
@@ -357,11 +357,11 @@ static float _time(float j) {
   }
 
   uint8_t UserModLive::compile(const char * fileName, const char * post) {
-    ppf("live compile n:%s o:%s \n", fileName, this->fileName);
+    ppfI(lc_live, "live compile n:%s o:%s \n", fileName, this->fileName);
 
     File f = files->open(fileName, FILE_READ);
     if (!f) {
-      ppf("UserModLive setup script open %s for %s failed\n", fileName, FILE_READ);
+      ppfE(lc_live, "UserModLive setup script open %s for %s failed\n", fileName, FILE_READ);
       return UINT8_MAX;
     } else {
 
@@ -372,7 +372,7 @@ static float _time(float j) {
         if (scScript[i] == '\n')
           preScriptNrOfLines++;
       }
-      ppf("preScript of %s has %d lines\n", fileName, preScriptNrOfLines+1); //+1 to subtract the line from parser error line reported
+      ppfD(lc_live, "preScript of %s has %d lines\n", fileName, preScriptNrOfLines+1); //+1 to subtract the line from parser error line reported
 
       scScript += string(f.readString().c_str()); // add sc file
       f.close();
@@ -380,35 +380,37 @@ static float _time(float j) {
       if (post) scScript += post;
 
       //print the script
+      #if STARBASE_LOG_LEVEL >= LOG_DEBUG
       size_t scripLines = 0;
       size_t lastIndex = 0;
       for (size_t i = 0; i < scScript.length(); i++)
       {
         if (scScript[i] == '\n' || i == scScript.length()-1) {
-          ppf("%3d %s", scripLines+1, scScript.substr(lastIndex, i-lastIndex+1).c_str());
+          ppfD(lc_live, "%3d %s", scripLines+1, scScript.substr(lastIndex, i-lastIndex+1).c_str());
           scripLines++;
           lastIndex = i + 1;
         }
       }
-      ppf("\n");
+      ppfD(lc_live, "\n");
+      #endif
 
-      ppf("Before parsing of %s\n", fileName);
-      ppf("Heap %s:%d f:%d / t:%d (l:%d) B [%d %d]\n", __FUNCTION__, __LINE__, ESP.getFreeHeap(), ESP.getHeapSize(), ESP.getMaxAllocHeap(), esp_get_free_heap_size(), esp_get_free_internal_heap_size());
-      ppf("Stack %d of %d B (async %d of %d B) %d\n", sys->sysTools_get_arduino_maxStackUsage(), getArduinoLoopTaskStackSize(), sys->sysTools_get_webserver_maxStackUsage(), CONFIG_ASYNC_TCP_STACK_SIZE, uxTaskGetStackHighWaterMark(xTaskGetCurrentTaskHandle()));
+      ppfD(lc_live, "Before parsing of %s\n", fileName);
+      ppfD(lc_live, "Heap %s:%d f:%d / t:%d (l:%d) B [%d %d]\n", __FUNCTION__, __LINE__, ESP.getFreeHeap(), ESP.getHeapSize(), ESP.getMaxAllocHeap(), esp_get_free_heap_size(), esp_get_free_internal_heap_size());
+      ppfD(lc_live, "Stack %d of %d B (async %d of %d B) %d\n", sys->sysTools_get_arduino_maxStackUsage(), getArduinoLoopTaskStackSize(), sys->sysTools_get_webserver_maxStackUsage(), CONFIG_ASYNC_TCP_STACK_SIZE, uxTaskGetStackHighWaterMark(xTaskGetCurrentTaskHandle()));
 
       Executable executable = parser.parseScript(&scScript);
       executable.name = string(fileName);
 
-      ppf("parsing %s done\n", fileName);
-      ppf("%s:%d f:%d / t:%d (l:%d) B [%d %d]\n", __FUNCTION__, __LINE__, ESP.getFreeHeap(), ESP.getHeapSize(), ESP.getMaxAllocHeap(), esp_get_free_heap_size(), esp_get_free_internal_heap_size());
+      ppfD(lc_live, "parsing %s done\n", fileName);
+      ppfD(lc_live, "%s:%d f:%d / t:%d (l:%d) B [%d %d]\n", __FUNCTION__, __LINE__, ESP.getFreeHeap(), ESP.getHeapSize(), ESP.getMaxAllocHeap(), esp_get_free_heap_size(), esp_get_free_internal_heap_size());
 
       scriptRuntime.addExe(executable);
 
       if (executable.exeExist) {
-        ppf("exe created %d\n", scriptRuntime._scExecutables.size());
+        ppfI(lc_live, "exe created %d\n", scriptRuntime._scExecutables.size());
         return scriptRuntime._scExecutables.size() - 1;
       } else {
-        ppf("exe failed %d\n", scriptRuntime._scExecutables.size());
+        ppfE(lc_live, "exe failed %d\n", scriptRuntime._scExecutables.size());
         return UINT8_MAX;
       }
     } //file open
@@ -424,7 +426,7 @@ static float _time(float j) {
 
     if (waitingOnLiveScript) {
       waitingOnLiveScript = false;
-      ppf("waitingOnLiveScript killAndDelete %d\n", waitingOnLiveScript);
+      ppfD(lc_live, "waitingOnLiveScript killAndDelete %d\n", waitingOnLiveScript);
     }
 
     // fix->liveFixtureID = nullptr; //to be sure! todo: nullify exec pointers fix->liveFixtureID and leds.liveEffectID
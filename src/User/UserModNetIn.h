@@ -0,0 +1,373 @@
+/*
+   @title     StarLight
+   @file      UserModNetIn.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#include <AsyncUDP.h>
+#include <atomic>
+
+#define NETIN_E131_PORT 5568
+#define NETIN_ARTNET_PORT 6454
+#define NETIN_DDP_PORT 4048
+
+#define NETIN_E131_HEADER_SIZE 126 //root, framing and dmp layer including the start code
+#define NETIN_ARTNET_HEADER_SIZE 18
+#define NETIN_DDP_HEADER_SIZE 10 //+ 4 with timecode
+#define NETIN_PACKET_SIZE 1460 //DDP 10 + 1440 channels, E1.31 126 + 512, Art-Net 18 + 512
+#define NETIN_QUEUE_SIZE 16 //packets received between two loops
+
+enum NetInProtocol {
+  np_e131,
+  np_artnet,
+  np_ddp,
+  np_count
+};
+
+//the decoded header of a received packet
+struct NetInData {
+  uint8_t protocol;
+  uint16_t universe = 0; //E1.31 universe or Art-Net port address, not for DDP
+  uint8_t sequence = 0;
+  uint32_t channel = 0; //DDP offset
+  const uint8_t *data = nullptr;
+  uint16_t length = 0; //nr of channels in data
+};
+
+//check and decode the header of packet received on the port of protocol, false if it contains no pixel data
+inline bool netInDecode(uint8_t protocol, const uint8_t *packet, size_t length, NetInData &in) {
+  in.protocol = protocol;
+  switch (protocol) {
+  case np_e131: {
+    if (length < NETIN_E131_HEADER_SIZE || memcmp(packet + 4, "ASC-E1.17", 9) != 0) return false;
+    if (packet[21] != 0x04 || packet[43] != 0x02 || packet[117] != 0x02) return false; //root E131_DATA, framing DATA_PACKET, dmp SET_PROPERTY
+    if (packet[112] & 0x40 || packet[125] != 0) return false; //preview data or not the null start code
+    in.sequence = packet[111];
+    in.universe = (packet[113] << 8) | packet[114];
+    uint16_t count = (packet[123] << 8) | packet[124]; //including the start code
+    in.length = count?min((size_t)count - 1, length - NETIN_E131_HEADER_SIZE):0;
+    in.data = packet + NETIN_E131_HEADER_SIZE;
+    return true; }
+  case np_artnet: {
+    if (length < NETIN_ARTNET_HEADER_SIZE || memcmp(packet, "Art-Net", 8) != 0) return false;
+    if ((packet[8] | (packet[9] << 8)) != 0x5000) return false; //OpDmx, ArtSync: the data is shown when received anyway
+    in.sequence = packet[12];
+    in.universe = (packet[14] | (packet[15] << 8)) & 0x7FFF;
+    in.length = min((size_t)((packet[16] << 8) | packet[17]), length - NETIN_ARTNET_HEADER_SIZE);
+    in.data = packet + NETIN_ARTNET_HEADER_SIZE;
+    return true; }
+  case np_ddp: {
+    if (length < NETIN_DDP_HEADER_SIZE || (packet[0] & 0xC0) != 0x40) return false; //version 1
+    if (packet[0] & 0x02 || packet[3] != 1) return false; //query or not the display
+    size_t headerSize = packet[0] & 0x10?NETIN_DDP_HEADER_SIZE + 4:NETIN_DDP_HEADER_SIZE; //timecode
+    if (length < headerSize) return false;
+    in.sequence = packet[1] & 0x0F;
+    in.channel = ((uint32_t)packet[4] << 24) | (packet[5] << 16) | (packet[6] << 8) | packet[7];
+    in.length = min((size_t)((packet[8] << 8) | packet[9]), length - headerSize);
+    in.data = packet + headerSize; //push: the data is shown when received anyway
+    return true; }
+  default: return false;
+  }
+}
+
+//track the sequence of a stream: returns the nr of missing packets, -1 if sequence is older than last (out of order or duplicate, to be dropped)
+//E1.31 uses 0..255, Art-Net 1..255 and DDP 1..15, 0 is not used for Art-Net and DDP, last UINT16_MAX: nothing received yet
+inline int netInSequence(uint16_t &last, uint8_t sequence, uint8_t protocol) {
+  if (protocol != np_e131 && sequence == 0) return 0;
+  const int count = protocol == np_e131?256:protocol == np_artnet?255:15;
+  const int value = protocol == np_e131?sequence:sequence - 1;
+  if (last == UINT16_MAX) {
+    last = value;
+    return 0;
+  }
+  const int diff = (value - last + count) % count;
+  if (diff == 0 || diff > count / 2) return -1;
+  last = value;
+  return diff - 1;
+}
+
+//the channels of E1.31 and Art-Net universes in the leds
+struct NetInUniverse {
+  uint16_t universe;
+  size_t channel; //first channel in the leds (led * 3)
+  uint16_t channels;
+  uint16_t lastSequence[np_ddp] = {UINT16_MAX, UINT16_MAX}; //E1.31 and Art-Net
+};
+
+//add the universes of nrOfLeds leds from startLed on, from universe on, 510 (170 leds) or 512 channels per universe
+inline void netInAddInput(std::vector<NetInUniverse> &universes, size_t startLed, size_t nrOfLeds, uint16_t universe, bool pack512) {
+  const size_t channelsPerUniverse = pack512?512:510;
+  const size_t endChannel = (startLed + nrOfLeds) * sizeof(CRGB);
+  for (size_t channel = startLed * sizeof(CRGB); channel < endChannel; channel += channelsPerUniverse) {
+    NetInUniverse netInUniverse;
+    netInUniverse.universe = universe++;
+    netInUniverse.channel = channel;
+    netInUniverse.channels = min(channelsPerUniverse, endChannel - channel);
+    universes.push_back(netInUniverse);
+  }
+}
+
+//the universe of E1.31 and Art-Net data, nullptr if not mapped
+inline NetInUniverse *netInUniverse(std::vector<NetInUniverse> &universes, uint16_t universe) {
+  for (NetInUniverse &netInUniverse: universes)
+    if (netInUniverse.universe == universe) return &netInUniverse;
+  return nullptr;
+}
+
+//copy the data of in to channel of the leds (nrOfChannels), returns the nr of channels copied
+inline size_t netInWrite(const NetInData &in, size_t channel, size_t maxLength, CRGB *leds, size_t nrOfChannels) {
+  if (channel >= nrOfChannels) return 0;
+  const size_t length = min(min((size_t)in.length, maxLength), nrOfChannels - channel);
+  memcpy(&leds[0].r + channel, in.data, length); //leds is a continuous array of r,g,b bytes
+  return length;
+}
+
+//packets received by the AsyncUDP task, decoded by loop: one producer and one consumer, no locks
+class NetInQueue {
+
+public:
+
+  struct Slot {
+    uint8_t protocol;
+    uint16_t length;
+    unsigned long micros; //received
+    uint8_t packet[NETIN_PACKET_SIZE];
+  };
+
+  unsigned long dropped = 0; //queue full
+
+  //allocated on first use and kept: the AsyncUDP task may still be in push after close
+  void reset() {
+    if (slots.empty()) {
+      slots.resize(NETIN_QUEUE_SIZE);
+      slots.shrink_to_fit();
+    }
+    head = 0;
+    tail = 0;
+  }
+
+  //producer, returns false if the queue is full or not allocated
+  bool push(uint8_t protocol, const uint8_t *packet, size_t length, unsigned long receivedMicros) {
+    const size_t h = head.load(std::memory_order_relaxed);
+    if (slots.empty() || h - tail.load(std::memory_order_acquire) >= slots.size()) {
+      dropped++;
+      return false;
+    }
+    Slot &slot = slots[h % slots.size()];
+    slot.protocol = protocol;
+    slot.length = min(length, sizeof(slot.packet));
+    slot.micros = receivedMicros;
+    memcpy(slot.packet, packet, slot.length);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  //consumer, nullptr if empty, pop after the slot is processed
+  const Slot *front() const {
+    const size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return nullptr;
+    return &slots[t % slots.size()];
+  }
+
+  void pop() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  private:
+    std::vector<Slot> slots;
+    std::atomic<size_t> head{0}; //written by the producer
+    std::atomic<size_t> tail{0}; //written by the consumer
+};
+
+//a pixel node: E1.31, Art-Net and DDP pixel data straight into the leds, set the effect of the layers to none so they do not overwrite it
+class UserModNetIn:public SysModule {
+
+public:
+
+  std::vector<uint16_t> inputUniverse = {1}; //E1.31 universe or Art-Net port address (net * 256 + subnet * 16 + universe)
+  std::vector<uint16_t> inputStart = {0}; //first led
+  std::vector<uint16_t> inputSize = {1024};
+  bool3State pack512 = false;
+
+  NetInQueue queue;
+
+  UserModNetIn() :SysModule("NetIn") {
+    isEnabled = false; //default off
+  };
+
+  void setup() override {
+    SysModule::setup();
+
+    const Variable parentVar = ui->initUserMod(Variable(), name, 6200);
+
+    ui->initCheckBox(parentVar, "pack512", &pack512, false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("512 channels per universe, else 510 (170 leds)");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
+      default: return false;
+    }});
+
+    Variable currentVar = ui->initText(parentVar, "status", nullptr, 64, true);
+    currentVar.setComment("Per second: packets, missing (sequence gaps), dropped (queue full or out of order), latency avg max");
+    currentVar.subscribe(onLoop1s, [this](EventArguments) {
+      variable.setValueF("%lu packets %lu missing %lu dropped %lu<%lu µs", packetCounter, missingCounter, queue.dropped - queueDropped + outOfOrderCounter, packetCounter?latencySum / packetCounter:0, latencyMax);
+      packetCounter = 0;
+      missingCounter = 0;
+      queueDropped = queue.dropped;
+      outOfOrderCounter = 0;
+      latencySum = 0;
+      latencyMax = 0;
+    });
+
+    Variable tableVar = ui->initTable(parentVar, "inputs");
+
+    ui->initNumber(tableVar, "universe", &inputUniverse, 0, UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("Start universe, E1.31 (unicast and multicast) or Art-Net, DDP is not mapped");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
+      default: return false;
+    }});
+    ui->initNumber(tableVar, "led", &inputStart, 0, UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("First led");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
+      default: return false;
+    }});
+    ui->initNumber(tableVar, "size", &inputSize, 0, UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("# pixels");
+        return true;
+      case onChange:
+        doMakeUniverses = true;
+        return true;
+      default: return false;
+    }});
+  }
+
+  void onOffChanged() override {
+    if (mdls->isConnected && isEnabled) {
+      if (listening) return;
+      queue.reset(); //nothing received while not listening
+      const uint16_t ports[np_count] = {NETIN_E131_PORT, NETIN_ARTNET_PORT, NETIN_DDP_PORT};
+      for (uint8_t protocol = 0; protocol < np_count; protocol++) {
+        if (!udp[protocol].listen(ports[protocol]))
+          ppf("NetIn listen %d failed\n", ports[protocol]);
+        udp[protocol].onPacket([this, protocol](AsyncUDPPacket &packet) {
+          queue.push(protocol, packet.data(), packet.length(), micros());
+        });
+      }
+      listening = true;
+      joinedUniverses.clear(); //joined again on the (new) connection
+      doMakeUniverses = true;
+    } else if (listening) {
+      for (AsyncUDP &u: udp) u.close();
+      listening = false;
+    }
+  }
+
+  //universes of all inputs, called if the inputs changed
+  void makeUniverses() {
+    universes.clear();
+    for (size_t input = 0; input < inputSize.size(); input++) {
+      size_t startLed = input < inputStart.size()?inputStart[input]:0;
+      uint16_t universe = input < inputUniverse.size()?inputUniverse[input]:0;
+      netInAddInput(universes, startLed, inputSize[input], universe, pack512);
+    }
+    universes.shrink_to_fit();
+    if (listening) joinUniverses();
+    doMakeUniverses = false;
+  }
+
+  //E1.31 sources send to multicast 239.255.hi.lo by default: join the groups of the mapped universes, unicast is received anyway
+  //lwIP has a few groups only (MEMP_NUM_IGMP_GROUP), the universes after the last group joined are unicast only. Groups are not left
+  void joinUniverses() {
+    for (const NetInUniverse &netInUniverse: universes) {
+      if (netInUniverse.universe == 0 || netInUniverse.universe > 63999) continue; //no E1.31 universe
+      if (std::find(joinedUniverses.begin(), joinedUniverses.end(), netInUniverse.universe) != joinedUniverses.end()) continue;
+      if (!udp[np_e131].listenMulticast(IPAddress(239, 255, netInUniverse.universe >> 8, netInUniverse.universe & 0xFF), NETIN_E131_PORT)) {
+        ppfW(lc_network, "NetIn E1.31 multicast universe %d not joined, unicast only from here\n", netInUniverse.universe);
+        break;
+      }
+      joinedUniverses.push_back(netInUniverse.universe);
+    }
+  }
+
+  //drain every packet received since the last loop into the leds
+  void loop() override {
+    // SysModule::loop();
+
+    if (!listening) return;
+
+    if (doMakeUniverses) makeUniverses();
+
+    const size_t nrOfChannels = min(fix->nrOfLeds, fix->ledsPSize) * sizeof(CRGB); //ledsPSize: less if allocation failed
+
+    while (const NetInQueue::Slot *slot = queue.front()) {
+      receive(*slot, fix->ledsP, nrOfChannels);
+      queue.pop();
+    }
+  }
+
+  //one packet into leds and the statistics
+  void receive(const NetInQueue::Slot &slot, CRGB *leds, size_t nrOfChannels) {
+    NetInData in;
+    if (!netInDecode(slot.protocol, slot.packet, slot.length, in) || !in.data) return;
+
+    uint16_t *lastSequence = &ddpSequence;
+    size_t channel = in.channel;
+    size_t maxLength = SIZE_MAX;
+    if (in.protocol != np_ddp) {
+      NetInUniverse *universe = netInUniverse(universes, in.universe);
+      if (!universe) return; //not for us
+      lastSequence = &universe->lastSequence[in.protocol];
+      channel = universe->channel;
+      maxLength = universe->channels;
+    }
+
+    int missing = netInSequence(*lastSequence, in.sequence, in.protocol);
+    if (missing < 0) {
+      outOfOrderCounter++;
+      return;
+    }
+    missingCounter += missing;
+
+    netInWrite(in, channel, maxLength, leds, nrOfChannels);
+
+    const unsigned long latency = micros() - slot.micros;
+    latencySum += latency;
+    latencyMax = max(latencyMax, latency);
+    packetCounter++;
+  }
+
+  private:
+    AsyncUDP udp[np_count];
+    bool listening = false;
+
+    std::vector<NetInUniverse> universes;
+    std::vector<uint16_t> joinedUniverses; //E1.31 multicast groups
+    bool doMakeUniverses = true;
+    uint16_t ddpSequence = UINT16_MAX;
+
+    unsigned long packetCounter = 0; //per second
+    unsigned long missingCounter = 0;
+    unsigned long outOfOrderCounter = 0;
+    unsigned long queueDropped = 0; //queue.dropped of the previous second
+    unsigned long latencySum = 0;
+    unsigned long latencyMax = 0;
+};
+
+extern UserModNetIn *netinmod;
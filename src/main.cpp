@@ -47,6 +47,10 @@ UserModMDNS *mdns;
     #include "User/UserModDDP.h"
     UserModDDP *ddpmod;
   #endif
+  #ifdef STARLIGHT_USERMOD_NETIN
+    #include "User/UserModNetIn.h"
+    UserModNetIn *netinmod;
+  #endif
 #endif
 #ifdef STARBASE_USERMOD_E131
   #include "User/UserModE131.h"
@@ -100,6 +104,9 @@ void setup() {
     #ifdef STARLIGHT_USERMOD_DDP
       ddpmod = new UserModDDP();
     #endif
+    #ifdef STARLIGHT_USERMOD_NETIN
+      netinmod = new UserModNetIn();
+    #endif
   #endif
   #ifdef STARBASE_USERMOD_E131
     e131mod = new UserModE131();
@@ -141,6 +148,9 @@ void setup() {
     #ifdef STARLIGHT_USERMOD_ARTNET
       mdls->add(artnetmod);
     #endif
+    #ifdef STARLIGHT_USERMOD_NETIN
+      mdls->add(netinmod);
+    #endif
   #endif
   #ifdef STARBASE_USERMOD_E131
     mdls->add(e131mod);
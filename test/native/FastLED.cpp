@@ -0,0 +1,319 @@
+/*
+   @title     StarLight
+   @file      FastLED.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// implementation of the FastLED subset in shim/FastLED.h (native env only)
+
+#include "FastLED.h"
+
+uint16_t rand16seed = 1337;
+
+CFastLED FastLED;
+
+//noise
+
+static const uint8_t p[] = {151,160,137,91,90,15,
+  131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
+  190,6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,
+  88,237,149,56,87,174,20,125,136,171,168,68,175,74,165,71,134,139,48,27,166,
+  77,146,158,231,83,111,229,122,60,211,133,230,220,105,92,41,55,46,245,40,244,
+  102,143,54,65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,169,200,196,
+  135,130,116,188,159,86,164,100,109,198,173,186,3,64,52,217,226,250,124,123,
+  5,202,38,147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,
+  223,183,170,213,119,248,152,2,44,154,163,70,221,153,101,155,167,43,172,9,
+  129,22,39,253,19,98,108,110,79,113,224,232,178,185,112,104,218,246,97,228,
+  251,34,242,193,238,210,144,12,191,179,162,241,81,51,145,235,249,14,239,107,
+  49,192,214,31,181,199,106,157,184,84,204,176,115,121,50,45,127,4,150,254,
+  138,236,205,93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,151};
+
+#define P(x) p[(x) & 0xFF]
+
+static int8_t avg7(int8_t i, int8_t j) {return (i >> 1) + (j >> 1) + (i & 0x1);}
+
+static int8_t lerp7by8(int8_t a, int8_t b, fract8 frac) {
+  if (b > a) return a + scale8((uint8_t)(b - a), frac);
+  return a - scale8((uint8_t)(a - b), frac);
+}
+
+static int8_t grad8(uint8_t hash, int8_t x, int8_t y, int8_t z) {
+  hash = hash & 0xF;
+  int8_t u = (hash & 8)?y:x;
+  int8_t v = hash < 4?y:(hash == 12 || hash == 14)?x:z;
+  if (hash & 1) u = -u;
+  if (hash & 2) v = -v;
+  return avg7(u, v);
+}
+
+static int8_t inoise8_raw(uint16_t x, uint16_t y, uint16_t z) {
+  uint8_t X = x >> 8;
+  uint8_t Y = y >> 8;
+  uint8_t Z = z >> 8;
+
+  uint8_t A = P(X) + Y;
+  uint8_t AA = P(A) + Z;
+  uint8_t AB = P(A + 1) + Z;
+  uint8_t B = P(X + 1) + Y;
+  uint8_t BA = P(B) + Z;
+  uint8_t BB = P(B + 1) + Z;
+
+  uint8_t u = ease8InOutQuad(x);
+  uint8_t v = ease8InOutQuad(y);
+  uint8_t w = ease8InOutQuad(z);
+
+  int8_t xx = (x >> 1) & 0x7F;
+  int8_t yy = (y >> 1) & 0x7F;
+  int8_t zz = (z >> 1) & 0x7F;
+  const int8_t N = 0x80;
+
+  int8_t X1 = lerp7by8(grad8(P(AA), xx, yy, zz), grad8(P(BA), xx - N, yy, zz), u);
+  int8_t X2 = lerp7by8(grad8(P(AB), xx, yy - N, zz), grad8(P(BB), xx - N, yy - N, zz), u);
+  int8_t X3 = lerp7by8(grad8(P(AA + 1), xx, yy, zz - N), grad8(P(BA + 1), xx - N, yy, zz - N), u);
+  int8_t X4 = lerp7by8(grad8(P(AB + 1), xx, yy - N, zz - N), grad8(P(BB + 1), xx - N, yy - N, zz - N), u);
+
+  int8_t Y1 = lerp7by8(X1, X2, v);
+  int8_t Y2 = lerp7by8(X3, X4, v);
+
+  return lerp7by8(Y1, Y2, w);
+}
+
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z) {
+  int8_t n = inoise8_raw(x, y, z); // -64..+64
+  n += 64;                         //   0..128
+  return qadd8(n, n);              //   0..255
+}
+
+//2D and 1D use the 3D noise in the z=0 plane (FastLED has dedicated variants, cost is comparable)
+uint8_t inoise8(uint16_t x, uint16_t y) {return inoise8(x, y, 0);}
+uint8_t inoise8(uint16_t x) {return inoise8(x, 0, 0);}
+
+//colors
+
+#define K255 255
+#define K171 171
+#define K170 170
+#define K85  85
+
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb) {
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+
+  uint8_t offset = hue & 0x1F; // 0..31
+  uint8_t offset8 = offset << 3;
+  uint8_t third = scale8(offset8, (256 / 3)); // max = 85
+
+  uint8_t r, g, b;
+
+  if (!(hue & 0x80)) {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {r = K255 - third; g = third; b = 0;}            // R -> O
+      else {r = K171; g = K85 + third; b = 0;}                             // O -> Y
+    }
+    else {
+      if (!(hue & 0x20)) {uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); r = K171 - twothirds; g = K170 + third; b = 0;} // Y -> G
+      else {r = 0; g = K255 - third; b = third;}                           // G -> A
+    }
+  }
+  else {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {r = 0; uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); g = K171 - twothirds; b = K85 + twothirds;} // A -> B
+      else {r = third; g = 0; b = K255 - third;}                           // B -> P
+    }
+    else {
+      if (!(hue & 0x20)) {r = K85 + third; g = 0; b = K171 - third;}      // P -> K
+      else {r = K170 + third; g = 0; b = K85 - third;}                     // K -> R
+    }
+  }
+
+  if (sat != 255) {
+    if (sat == 0) {
+      r = 255; b = 255; g = 255;
+    }
+    else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+      r = scale8(r, satscale) + desat;
+      g = scale8(g, satscale) + desat;
+      b = scale8(b, satscale) + desat;
+    }
+  }
+
+  if (val != 255) {
+    val = scale8_video(val, val);
+    if (val == 0) {
+      r = 0; g = 0; b = 0;
+    }
+    else {
+      r = scale8(r, val);
+      g = scale8(g, val);
+      b = scale8(b, val);
+    }
+  }
+
+  rgb.r = r;
+  rgb.g = g;
+  rgb.b = b;
+}
+
+CHSV rgb2hsv_approximate(const CRGB &rgb) {
+  uint8_t maxC = max(rgb.r, max(rgb.g, rgb.b));
+  uint8_t minC = min(rgb.r, min(rgb.g, rgb.b));
+  uint8_t delta = maxC - minC;
+  if (maxC == 0) return CHSV(0, 0, 0);
+  uint8_t s = (uint16_t)delta * 255 / maxC;
+  if (delta == 0) return CHSV(0, 0, maxC);
+  int16_t h;
+  if (maxC == rgb.r) h = 43 * (rgb.g - rgb.b) / delta;
+  else if (maxC == rgb.g) h = 85 + 43 * (rgb.b - rgb.r) / delta;
+  else h = 171 + 43 * (rgb.r - rgb.g) / delta;
+  return CHSV((uint8_t)h, s, maxC);
+}
+
+CRGB HeatColor(uint8_t temperature) {
+  CRGB heatcolor;
+  uint8_t t192 = scale8_video(temperature, 191);
+  uint8_t heatramp = t192 & 0x3F; // 0..63
+  heatramp <<= 2; // scale up to 0..252
+  if (t192 & 0x80) {heatcolor.r = 255; heatcolor.g = 255; heatcolor.b = heatramp;}
+  else if (t192 & 0x40) {heatcolor.r = 255; heatcolor.g = heatramp; heatcolor.b = 0;}
+  else {heatcolor.r = heatramp; heatcolor.g = 0; heatcolor.b = 0;}
+  return heatcolor;
+}
+
+void fill_solid(CRGB *targetArray, int numToFill, const CRGB &color) {
+  for (int i = 0; i < numToFill; ++i) targetArray[i] = color;
+}
+
+void fill_rainbow(CRGB *targetArray, int numToFill, uint8_t initialhue, uint8_t deltahue) {
+  CHSV hsv;
+  hsv.hue = initialhue;
+  hsv.val = 255;
+  hsv.sat = 240;
+  for (int i = 0; i < numToFill; ++i) {
+    targetArray[i] = hsv;
+    hsv.hue += deltahue;
+  }
+}
+
+void nscale8(CRGB *leds, uint16_t num_leds, uint8_t scale) {
+  for (uint16_t i = 0; i < num_leds; ++i) leds[i].nscale8(scale);
+}
+
+void fadeToBlackBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy) {nscale8(leds, num_leds, 255 - fadeBy);}
+
+void blur1d(CRGB *leds, uint16_t numLeds, fract8 blur_amount) {
+  uint8_t keep = 255 - blur_amount;
+  uint8_t seep = blur_amount >> 1;
+  CRGB carryover = CRGB::Black;
+  for (uint16_t i = 0; i < numLeds; ++i) {
+    CRGB cur = leds[i];
+    CRGB part = cur;
+    part.nscale8(seep);
+    cur.nscale8(keep);
+    cur += carryover;
+    if (i) leds[i - 1] += part;
+    leds[i] = cur;
+    carryover = part;
+  }
+}
+
+//palettes
+
+CRGB ColorFromPalette(const CRGBPalette16 &pal, uint8_t index, uint8_t brightness, TBlendType blendType) {
+  uint8_t hi4 = index >> 4;
+  uint8_t lo4 = index & 0x0F;
+
+  const CRGB *entry = &(pal[0]) + hi4;
+
+  uint8_t red1 = entry->red;
+  uint8_t green1 = entry->green;
+  uint8_t blue1 = entry->blue;
+
+  if (lo4 && blendType != NOBLEND) {
+    if (hi4 == 15) entry = &(pal[0]); else ++entry;
+
+    uint8_t f2 = lo4 << 4;
+    uint8_t f1 = 255 - f2;
+
+    red1 = scale8(red1, f1) + scale8(entry->red, f2);
+    green1 = scale8(green1, f1) + scale8(entry->green, f2);
+    blue1 = scale8(blue1, f1) + scale8(entry->blue, f2);
+  }
+
+  if (brightness != 255) {
+    if (brightness) {
+      ++brightness; // adjust for rounding
+      red1 = scale8(red1, brightness);
+      green1 = scale8(green1, brightness);
+      blue1 = scale8(blue1, brightness);
+    }
+    else {
+      red1 = 0; green1 = 0; blue1 = 0;
+    }
+  }
+
+  return CRGB(red1, green1, blue1);
+}
+
+const TProgmemRGBPalette16 CloudColors_p = {
+  CRGB::Blue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+  CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+  CRGB::Blue, CRGB::DarkBlue, CRGB::SkyBlue, CRGB::SkyBlue,
+  CRGB::LightBlue, CRGB::White, CRGB::LightBlue, CRGB::SkyBlue
+};
+
+const TProgmemRGBPalette16 LavaColors_p = {
+  CRGB::Black, CRGB::Maroon, CRGB::Black, CRGB::Maroon,
+  CRGB::DarkRed, CRGB::DarkRed, CRGB::Maroon, CRGB::DarkRed,
+  CRGB::DarkRed, CRGB::DarkRed, CRGB::Red, CRGB::Orange,
+  CRGB::White, CRGB::Orange, CRGB::Red, CRGB::DarkRed
+};
+
+const TProgmemRGBPalette16 OceanColors_p = {
+  CRGB::MidnightBlue, CRGB::DarkBlue, CRGB::MidnightBlue, CRGB::Navy,
+  CRGB::DarkBlue, CRGB::MediumBlue, CRGB::SeaGreen, CRGB::Teal,
+  CRGB::CadetBlue, CRGB::Blue, CRGB::DarkCyan, CRGB::CornflowerBlue,
+  CRGB::Aquamarine, CRGB::SeaGreen, CRGB::Aqua, CRGB::LightSkyBlue
+};
+
+const TProgmemRGBPalette16 ForestColors_p = {
+  CRGB::DarkGreen, CRGB::DarkGreen, CRGB::DarkOliveGreen, CRGB::DarkGreen,
+  CRGB::Green, CRGB::ForestGreen, CRGB::OliveDrab, CRGB::Green,
+  CRGB::SeaGreen, CRGB::MediumAquamarine, CRGB::LimeGreen, CRGB::YellowGreen,
+  CRGB::LightGreen, CRGB::LawnGreen, CRGB::MediumAquamarine, CRGB::ForestGreen
+};
+
+const TProgmemRGBPalette16 RainbowColors_p = {
+  0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00,
+  0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+  0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5,
+  0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B
+};
+
+const TProgmemRGBPalette16 RainbowStripeColors_p = {
+  0xFF0000, 0x000000, 0xAB5500, 0x000000,
+  0xABAB00, 0x000000, 0x00FF00, 0x000000,
+  0x00AB55, 0x000000, 0x0000FF, 0x000000,
+  0x5500AB, 0x000000, 0xAB0055, 0x000000
+};
+
+const TProgmemRGBPalette16 PartyColors_p = {
+  0x5500AB, 0x84007C, 0xB5004B, 0xE5001B,
+  0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+  0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E,
+  0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9
+};
+
+const TProgmemRGBPalette16 HeatColors_p = {
+  0x000000, 0x330000, 0x660000, 0x990000, 0xCC0000, 0xFF0000,
+  0xFF3300, 0xFF6600, 0xFF9900, 0xFFCC00, 0xFFFF00,
+  0xFFFF33, 0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF
+};
@@ -0,0 +1,77 @@
+/*
+   @title     StarLight
+   @file      Loopback.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// host loopback UDP, test leds and throughput of the network tests (test_ddp, test_artnet, test_netin)
+
+#pragma once
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+#include <cstdio>
+
+#include "Arduino.h" //micros
+#include "FastLED.h" //CRGB
+
+#define TEST_NR_OF_LEDS 2000 //6000 channels
+#define TEST_FRAMES 200
+
+//a socket bound to a free port of 127.0.0.1, address: to send to it
+inline int loopbackReceiver(sockaddr_in &address) {
+  int receiver = socket(AF_INET, SOCK_DGRAM, 0);
+
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0; //any free port
+  bind(receiver, (sockaddr *)&address, sizeof(address));
+  socklen_t addressLength = sizeof(address);
+  getsockname(receiver, (sockaddr *)&address, &addressLength);
+
+  int bufferSize = 1 << 20; //a whole frame fits before it is received
+  setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+  return receiver;
+}
+
+inline void loopbackSend(int sender, const sockaddr_in &address, const uint8_t *packet, size_t length) {
+  sendto(sender, packet, length, 0, (const sockaddr *)&address, sizeof(address));
+}
+
+//test;step;packets/s;MB/s;µs/frame of frames send in elapsed µs
+inline void printThroughput(const char *test, const char *step, size_t packets, size_t bytes, size_t frames, unsigned long elapsed) {
+  if (elapsed == 0) elapsed = 1;
+  printf("%s;%s;packets/s %llu;MB/s %.1f;µs/frame %lu\n", test, step, packets * 1000000ULL / elapsed, (float)bytes / elapsed, elapsed / frames);
+}
+
+//every channel of every led different (within 8 bits)
+inline void fillTestLeds(CRGB *leds, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    leds[i] = CRGB(i, i >> 8, i * 7);
+}
+
+inline void fillTestLut(uint8_t lut[3][256], uint8_t brightness = 255) {
+  for (int i = 0; i < 256; i++) lut[0][i] = lut[1][i] = lut[2][i] = scale8(i, brightness);
+}
+
+//frame(frameNr, bytes) of TEST_FRAMES frames: returns its nr of packets and adds its bytes, returns the nr of packets of all frames
+template <typename Frame>
+inline size_t frameThroughput(const char *test, const char *step, Frame frame) {
+  size_t packets = 0;
+  size_t bytes = 0;
+  unsigned long start = micros();
+  for (int frameNr = 0; frameNr < TEST_FRAMES; frameNr++)
+    packets += frame(frameNr, bytes);
+  unsigned long elapsed = micros() - start;
+  printThroughput(test, step, packets, bytes, TEST_FRAMES, elapsed);
+  return packets;
+}
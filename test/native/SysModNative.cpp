@@ -0,0 +1,114 @@
+/*
+   @title     StarLight
+   @file      SysModNative.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// native env: globals normally defined in main.cpp and the esp32 core, and host versions of the
+// modules which are not compiled for native (SysModWeb, SysModSystem, SysModNetwork)
+
+#include "SysModule.h"
+#include "SysModules.h"
+#include "Sys/SysModPrint.h"
+#include "Sys/SysModWeb.h"
+#include "Sys/SysModUI.h"
+#include "Sys/SysModSystem.h"
+#include "Sys/SysModFiles.h"
+#include "Sys/SysModModel.h"
+#include "Sys/SysModNetwork.h"
+#include "Sys/SysModPins.h"
+#include "Sys/SysModInstances.h"
+#include "App/LedModEffects.h"
+#include "App/LedModFixture.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+TwoWire Wire;
+LittleFSFS LittleFS;
+
+SysModules *mdls;
+SysModPrint *print;
+SysModWeb *web;
+SysModUI *ui;
+SysModSystem *sys;
+SysModFiles *files;
+SysModModel *mdl;
+SysModNetwork *net;
+SysModPins *pinsM;
+SysModInstances *instances;
+LedModFixture *fix;
+LedModEffects *eff;
+
+//SysModWeb: no server and no clients, responses are dropped when send
+
+SysModWeb::SysModWeb() :SysModule("Web") {
+  responseDocLoopTask = new JsonDocument; responseDocLoopTask->to<JsonObject>();
+  responseDocAsyncTCP = new JsonDocument; responseDocAsyncTCP->to<JsonObject>();
+};
+
+void SysModWeb::setup() {
+  SysModule::setup();
+}
+
+void SysModWeb::loop20ms() {}
+
+void SysModWeb::loop1s() {
+  sendResponseObject();
+}
+
+void SysModWeb::reboot() {}
+
+void SysModWeb::connectedChanged() {}
+
+void SysModWeb::sendDataWs(JsonVariant json, WebClient * client) {}
+
+void SysModWeb::sendDataWs(std::function<void(AsyncWebSocketMessageBuffer *)> fill, size_t len, bool isBinary, WebClient * client) {}
+
+bool SysModWeb::sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, WebClient * client, bool lossless) {return true;}
+
+size_t SysModWeb::maxQueueLen() {return 0;}
+
+void SysModWeb::clientsToJson(JsonArray array, bool nameOnly, const char * filter) {}
+
+JsonDocument * SysModWeb::getResponseDoc() {
+  return strncmp(pcTaskGetTaskName(nullptr), "loopTask", 8) == 0?responseDocLoopTask:responseDocAsyncTCP;
+}
+
+JsonObject SysModWeb::getResponseObject() {
+  return getResponseDoc()->as<JsonObject>();
+}
+
+void SysModWeb::sendResponseObject(WebClient * client) {
+  if (getResponseObject().size())
+    getResponseDoc()->to<JsonObject>(); //recreate the response object as it would have been send
+}
+
+//SysModSystem: time only
+
+SysModSystem::SysModSystem() :SysModule("System") {};
+
+void SysModSystem::setup() {
+  SysModule::setup();
+}
+
+void SysModSystem::loop() {
+  now = millis() + timebase;
+}
+
+void SysModSystem::loop10s() {}
+
+bool SysModSystem::sysTools_normal_startup() {return true;} //called on a nullptr in the SysModPrint constructor, so no members
+
+String SysModSystem::sysTools_getRestartReason() {return String("native");}
+
+//SysModNetwork: never connected
+
+IPAddress SysModNetwork::localIP() {
+  return IPAddress();
+}
@@ -0,0 +1,357 @@
+/*
+   @title     StarLight
+   @file      Arduino.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// Minimal Arduino-ESP32 api for the native (Linux host) env: only what the render core (Sys + App) uses
+// not a full emulation, timing and memory calls map to the host
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <thread>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#ifndef PI
+  #define PI 3.1415926535897932384626433832795
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#ifndef M_TWOPI
+  #define M_TWOPI (M_PI * 2.0)
+#endif
+
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+#define IRAM_ATTR
+#define SET_LOOP_TASK_STACK_SIZE(size)
+
+//time
+
+inline unsigned long micros() {
+  static const auto start = std::chrono::steady_clock::now();
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+inline unsigned long millis() {return micros() / 1000;}
+inline void delay(uint32_t ms) {std::this_thread::sleep_for(std::chrono::milliseconds(ms));}
+inline void delayMicroseconds(uint32_t us) {std::this_thread::sleep_for(std::chrono::microseconds(us));}
+inline void yield() {}
+
+//math
+
+inline long random(long howbig) {return howbig <= 0?0:rand() % howbig;}
+inline long random(long howsmall, long howbig) {return howsmall >= howbig?howsmall:howsmall + random(howbig - howsmall);}
+inline void randomSeed(unsigned long seed) {srand(seed);}
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  if (in_max == in_min) return out_min;
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+//characters
+
+inline bool isDigit(int c) {return isdigit(c) != 0;}
+inline bool isAlpha(int c) {return isalpha(c) != 0;}
+inline bool isSpace(int c) {return isspace(c) != 0;}
+
+//strings (bsd extensions available on esp32 newlib)
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len >= size?size - 1:len;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+inline size_t strlcat(char *dst, const char *src, size_t size) {
+  size_t dlen = strnlen(dst, size);
+  if (dlen == size) return size + strlen(src);
+  return dlen + strlcpy(dst + dlen, src, size - dlen);
+}
+#endif
+
+inline char *strnstr(const char *haystack, const char *needle, size_t len) {
+  size_t needleLen = strlen(needle);
+  if (needleLen == 0) return (char *)haystack;
+  for (size_t i = 0; i + needleLen <= len && haystack[i]; i++)
+    if (strncmp(haystack + i, needle, needleLen) == 0) return (char *)haystack + i;
+  return nullptr;
+}
+
+inline void *reallocf(void *ptr, size_t size) {
+  void *result = realloc(ptr, size);
+  if (result == nullptr && size) free(ptr);
+  return result;
+}
+
+//memory: no psram on the host, heap_caps map to malloc
+
+#define MALLOC_CAP_8BIT 0
+#define MALLOC_CAP_SPIRAM 0
+#define MALLOC_CAP_INTERNAL 0
+#define MALLOC_CAP_DEFAULT 0
+inline bool psramFound() {return false;}
+inline void *ps_malloc(size_t size) {return malloc(size);}
+inline void *ps_calloc(size_t n, size_t size) {return calloc(n, size);}
+inline void *ps_realloc(void *ptr, size_t size) {return realloc(ptr, size);}
+inline void *heap_caps_malloc(size_t size, uint32_t caps) {return malloc(size);}
+inline void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {return calloc(n, size);}
+inline void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps) {return realloc(ptr, size);}
+inline size_t heap_caps_get_free_size(uint32_t caps) {return 320 * 1024;}
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {return 110 * 1024;}
+inline size_t heap_caps_get_total_size(uint32_t caps) {return 320 * 1024;}
+
+//freertos: single task on the host
+
+typedef void *SemaphoreHandle_t;
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY UINT32_MAX
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {return (SemaphoreHandle_t)1;}
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, uint32_t) {return pdTRUE;}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) {return pdTRUE;}
+inline const char *pcTaskGetTaskName(TaskHandle_t) {return "loopTask";}
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {return nullptr;}
+inline uint32_t uxTaskGetStackHighWaterMark(TaskHandle_t) {return 0;}
+#define pdPASS pdTRUE
+#define pdMS_TO_TICKS(ms) (ms)
+inline BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char *name, uint32_t stackSize, void *parameter, uint32_t priority, TaskHandle_t *handle, BaseType_t core) {return pdFALSE;} //no tasks: callers do the work themselves
+inline void vTaskDelay(uint32_t ticks) {}
+
+typedef enum {
+  ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT, ESP_RST_TASK_WDT, ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO
+} esp_reset_reason_t;
+inline esp_reset_reason_t esp_reset_reason() {return ESP_RST_POWERON;}
+
+//pins: behave like an esp32 with nothing connected
+
+#define NUM_DIGITAL_PINS 40
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define LOW 0x0
+#define HIGH 0x1
+#define RX 3
+#define TX 1
+#define SERIAL_8N1 0x800001c
+inline bool digitalPinIsValid(uint8_t pin) {return pin < NUM_DIGITAL_PINS && pin != 20 && pin != 24 && (pin < 28 || pin > 31);}
+inline bool digitalPinCanOutput(uint8_t pin) {return pin < 34;}
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void digitalWrite(uint8_t pin, uint8_t val) {}
+inline int digitalRead(uint8_t pin) {return HIGH;}
+
+//String: std::string backed, api as far as used by StarBase and ArduinoJson
+
+class StringSumHelper;
+
+class String {
+public:
+  String(const char *cstr = "") {if (cstr) s = cstr;}
+  String(const char *cstr, size_t length) {if (cstr) s.assign(cstr, length);}
+  String(const std::string &str): s(str) {}
+  String(const __FlashStringHelper *fstr): String(reinterpret_cast<const char *>(fstr)) {}
+  explicit String(char c): s(1, c) {}
+  explicit String(int value, unsigned char base = 10): s(std::to_string(value)) {}
+  explicit String(unsigned int value, unsigned char base = 10): s(std::to_string(value)) {}
+  explicit String(long value, unsigned char base = 10): s(std::to_string(value)) {}
+  explicit String(unsigned long value, unsigned char base = 10): s(std::to_string(value)) {}
+  explicit String(float value, unsigned char decimalPlaces = 2) {char buf[32]; snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value); s = buf;}
+  explicit String(double value, unsigned char decimalPlaces = 2) {char buf[32]; snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value); s = buf;}
+
+  String &operator=(const char *cstr) {if (cstr) s = cstr; else s.clear(); return *this;}
+  String &operator=(const String &rhs) = default;
+
+  bool concat(const char *cstr) {if (!cstr) return false; s += cstr; return true;}
+  bool concat(const char *cstr, size_t length) {if (!cstr) return false; s.append(cstr, length); return true;}
+  bool concat(const String &str) {s += str.s; return true;}
+  bool concat(char c) {s += c; return true;}
+  String &operator+=(const char *cstr) {concat(cstr); return *this;}
+  String &operator+=(const String &str) {concat(str); return *this;}
+  String &operator+=(char c) {concat(c); return *this;}
+
+  friend StringSumHelper operator+(const String &lhs, const String &rhs);
+  friend StringSumHelper operator+(const String &lhs, const char *rhs);
+
+  bool operator==(const String &rhs) const {return s == rhs.s;}
+  bool operator==(const char *cstr) const {return cstr && s == cstr;}
+  bool operator!=(const String &rhs) const {return s != rhs.s;}
+  bool operator!=(const char *cstr) const {return !(*this == cstr);}
+  bool operator<(const String &rhs) const {return s < rhs.s;}
+
+  const char *c_str() const {return s.c_str();}
+  size_t length() const {return s.length();}
+  bool isEmpty() const {return s.empty();}
+  bool reserve(size_t size) {s.reserve(size); return true;}
+  char charAt(size_t index) const {return index < s.length()?s[index]:0;}
+  char operator[](size_t index) const {return charAt(index);}
+  char &operator[](size_t index) {return s[index];}
+  int indexOf(char c, size_t from = 0) const {size_t pos = s.find(c, from); return pos == std::string::npos?-1:(int)pos;}
+  int indexOf(const char *str, size_t from = 0) const {size_t pos = s.find(str, from); return pos == std::string::npos?-1:(int)pos;}
+  String substring(size_t from) const {return from < s.length()?String(s.substr(from)):String();}
+  String substring(size_t from, size_t to) const {return from < s.length() && to > from?String(s.substr(from, to - from)):String();}
+  bool startsWith(const char *prefix) const {return strncmp(s.c_str(), prefix, strlen(prefix)) == 0;}
+  bool endsWith(const char *suffix) const {size_t n = strlen(suffix); return n <= s.length() && s.compare(s.length() - n, n, suffix) == 0;}
+  long toInt() const {return atol(s.c_str());}
+  float toFloat() const {return atof(s.c_str());}
+  void toLowerCase() {for (char &c: s) c = tolower(c);}
+  void toUpperCase() {for (char &c: s) c = toupper(c);}
+  void trim() {
+    size_t first = s.find_first_not_of(" \t\r\n");
+    size_t last = s.find_last_not_of(" \t\r\n");
+    s = first == std::string::npos?"":s.substr(first, last - first + 1);
+  }
+
+private:
+  std::string s;
+};
+
+class StringSumHelper: public String {
+public:
+  StringSumHelper(const String &str): String(str) {}
+};
+
+inline StringSumHelper operator+(const String &lhs, const String &rhs) {String result(lhs); result.concat(rhs); return result;}
+inline StringSumHelper operator+(const String &lhs, const char *rhs) {String result(lhs); result.concat(rhs); return result;}
+
+//Print and Stream, ArduinoJson serializes to / deserializes from these
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char *str) {return str?write((const uint8_t *)str, strlen(str)):0;}
+  size_t write(const char *buffer, size_t size) {return write((const uint8_t *)buffer, size);}
+
+  size_t print(const char *str) {return write(str);}
+  size_t print(const String &str) {return write(str.c_str(), str.length());}
+  size_t print(const __FlashStringHelper *str) {return write(reinterpret_cast<const char *>(str));}
+  size_t print(char c) {return write((uint8_t)c);}
+  size_t print(int value) {return printf("%d", value);}
+  size_t print(unsigned int value) {return printf("%u", value);}
+  size_t print(long value) {return printf("%ld", value);}
+  size_t print(unsigned long value) {return printf("%lu", value);}
+  size_t print(double value, int digits = 2) {return printf("%.*f", digits, value);}
+  template <typename T>
+  size_t println(T value) {size_t n = print(value); return n + println();}
+  size_t println() {return write("\r\n");}
+
+  size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3))) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(buffer)) return write(buffer, len);
+    std::string big(len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    return write(big.c_str(), len);
+  }
+  virtual void flush() {}
+};
+
+class Stream: public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  size_t readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+      int c = read();
+      if (c < 0) break;
+      *buffer++ = (char)c;
+      count++;
+    }
+    return count;
+  }
+  size_t readBytes(uint8_t *buffer, size_t length) {return readBytes((char *)buffer, length);}
+  size_t readBytesUntil(char terminator, char *buffer, size_t length) {
+    size_t index = 0;
+    while (index < length) {
+      int c = read();
+      if (c < 0 || c == terminator) break;
+      *buffer++ = (char)c;
+      index++;
+    }
+    return index;
+  }
+  void setTimeout(unsigned long timeout) {}
+};
+
+#include "HardwareSerial.h"
+#include "IPAddress.h"
+
+//esp object
+
+class EspClass {
+public:
+  uint32_t getCycleCount() {return (uint32_t)micros() * getCpuFreqMHz();} //host has no cycle counter exposed, derived from micros
+  uint32_t getCpuFreqMHz() {return 240;}
+  uint32_t getFreeHeap() {return 320 * 1024;}
+  uint32_t getHeapSize() {return 320 * 1024;}
+  uint32_t getMaxAllocHeap() {return 110 * 1024;}
+  uint32_t getMinFreeHeap() {return 320 * 1024;}
+  uint32_t getFreePsram() {return 0;}
+  uint32_t getPsramSize() {return 0;}
+  uint32_t getFlashChipSize() {return 4 * 1024 * 1024;}
+  uint32_t getSketchSize() {return 0;}
+  uint32_t getFreeSketchSpace() {return 0;}
+  const char *getSdkVersion() {return "native";}
+  const char *getChipModel() {return "native";}
+  uint8_t getChipRevision() {return 0;}
+  uint8_t getChipCores() {return 1;}
+  void restart() {exit(0);}
+};
+
+extern EspClass ESP;
@@ -0,0 +1,32 @@
+/*
+   @title     StarLight
+   @file      AsyncUDP.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+#include <functional>
+
+class AsyncUDPPacket {
+public:
+  uint8_t * data() {return nullptr;}
+  size_t length() {return 0;}
+};
+
+//packets are dropped and nothing is received, tests use host sockets to check what would be send or received
+class AsyncUDP {
+public:
+  size_t writeTo(const uint8_t *data, size_t len, const IPAddress &addr, uint16_t port) {return len;}
+  bool listen(uint16_t port) {return true;}
+  bool listenMulticast(const IPAddress &addr, uint16_t port) {return true;}
+  void onPacket(std::function<void(AsyncUDPPacket &packet)> callback) {}
+  void close() {}
+};
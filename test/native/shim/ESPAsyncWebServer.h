@@ -0,0 +1,97 @@
+/*
+   @title     StarLight
+   @file      ESPAsyncWebServer.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+#include <vector>
+#include <deque>
+
+//web server types as used in SysModWeb.h, on the host there are never clients connected
+
+typedef enum {WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA} AwsEventType;
+typedef enum {WS_DISCONNECTED, WS_CONNECTED, WS_DISCONNECTING} AwsClientStatus;
+
+class AsyncWebSocket;
+
+class AsyncWebSocketMessageBuffer {
+public:
+  AsyncWebSocketMessageBuffer(size_t size): data(size) {}
+  uint8_t *get() {return data.data();}
+  size_t length() const {return data.size();}
+  void lock() {}
+  void unlock() {}
+private:
+  std::vector<uint8_t> data;
+};
+
+class AsyncWebSocketClient {
+public:
+  uint32_t id() const {return 0;}
+  IPAddress remoteIP() const {return IPAddress();}
+  AwsClientStatus status() const {return WS_DISCONNECTED;}
+  bool queueIsFull() const {return false;}
+  size_t queueLen() const {return 0;}
+  AsyncWebSocket *server() {return socket;}
+  void text(const char *message) {}
+  void text(AsyncWebSocketMessageBuffer *buffer) {}
+  void binary(AsyncWebSocketMessageBuffer *buffer) {}
+  void close() {}
+private:
+  AsyncWebSocket *socket = nullptr;
+};
+
+class AsyncWebSocketClientList: public std::vector<AsyncWebSocketClient *> {
+public:
+  size_t length() const {return size();}
+};
+
+class AsyncWebSocket {
+public:
+  AsyncWebSocket(const char *url) {}
+
+  AsyncWebSocketClientList &getClients() {return clients;}
+  size_t count() const {return clients.size();}
+  AsyncWebSocketMessageBuffer *makeBuffer(size_t size) {
+    buffers.emplace_back(size);
+    return &buffers.back();
+  }
+  void _cleanBuffers() {buffers.clear();}
+  void textAll(const char *message) {}
+  void textAll(AsyncWebSocketMessageBuffer *buffer) {}
+  void binaryAll(AsyncWebSocketMessageBuffer *buffer) {}
+  void cleanupClients() {}
+  bool availableForWriteAll() {return true;}
+
+private:
+  AsyncWebSocketClientList clients;
+  std::deque<AsyncWebSocketMessageBuffer> buffers; //deque: pointers stay valid on emplace_back
+};
+
+class AsyncWebServerResponse {
+public:
+  void addHeader(const char *name, const char *value) {}
+};
+
+class AsyncWebServerRequest {
+public:
+  void send(int code, const char *contentType = "", const String &content = String()) {}
+  void send(AsyncWebServerResponse *response) {}
+  IPAddress client_remoteIP() {return IPAddress();}
+  String url() {return String("/");}
+};
+
+class AsyncWebServer {
+public:
+  AsyncWebServer(uint16_t port) {}
+  void begin() {}
+  void end() {}
+};
@@ -0,0 +1,334 @@
+/*
+   @title     StarLight
+   @file      FastLED.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// FastLED subset for the native env: CRGB / CHSV / palettes and the lib8tion functions used by effects and projections
+// math follows the FastLED C implementations (not the asm ones) so timings are comparable, colors may differ in the last bit
+// show() does nothing: the native env measures rendering, not output
+
+#pragma once
+
+#include "Arduino.h"
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+typedef uint16_t accum88;
+
+#define LIB8STATIC inline
+#define LIB8STATIC_ALWAYS_INLINE inline
+
+// scaling and saturating math
+
+LIB8STATIC uint8_t scale8(uint8_t i, fract8 scale) {return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;}
+LIB8STATIC uint8_t scale8_video(uint8_t i, fract8 scale) {return (((int)i * (int)scale) >> 8) + ((i && scale)?1:0);}
+LIB8STATIC uint16_t scale16(uint16_t i, fract16 scale) {return ((uint32_t)i * (1 + (uint32_t)scale)) >> 16;}
+LIB8STATIC uint16_t scale16by8(uint16_t i, fract8 scale) {return (i * (1 + (uint32_t)scale)) >> 8;}
+LIB8STATIC uint8_t qadd8(uint8_t i, uint8_t j) {unsigned t = i + j; return t > 255?255:t;}
+LIB8STATIC uint8_t qsub8(uint8_t i, uint8_t j) {int t = i - j; return t < 0?0:t;}
+LIB8STATIC uint8_t add8(uint8_t i, uint8_t j) {return i + j;}
+LIB8STATIC uint8_t sub8(uint8_t i, uint8_t j) {return i - j;}
+LIB8STATIC uint8_t mul8(uint8_t i, uint8_t j) {return i * j;}
+LIB8STATIC uint8_t qmul8(uint8_t i, uint8_t j) {unsigned p = (unsigned)i * j; return p > 255?255:p;}
+LIB8STATIC uint8_t abs8(int8_t i) {return i < 0?-i:i;}
+LIB8STATIC uint8_t avg8(uint8_t i, uint8_t j) {return (i + j) >> 1;}
+LIB8STATIC uint8_t map8(uint8_t in, uint8_t rangeStart, uint8_t rangeEnd) {return rangeStart + scale8(in, rangeEnd - rangeStart);}
+LIB8STATIC uint8_t dim8_raw(uint8_t x) {return scale8(x, x);}
+LIB8STATIC uint8_t dim8_video(uint8_t x) {return scale8_video(x, x);}
+LIB8STATIC uint8_t brighten8_raw(uint8_t x) {uint8_t ix = 255 - x; return 255 - scale8(ix, ix);}
+LIB8STATIC uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {return b > a?a + scale8(b - a, frac):a - scale8(a - b, frac);}
+LIB8STATIC uint8_t triwave8(uint8_t in) {if (in & 0x80) in = 255 - in; return in << 1;}
+LIB8STATIC uint8_t ease8InOutQuad(uint8_t i) {uint8_t j = i; if (j & 0x80) j = 255 - j; uint8_t jj = scale8(j, j); uint8_t jj2 = jj << 1; if (i & 0x80) jj2 = 255 - jj2; return jj2;}
+LIB8STATIC uint8_t quadwave8(uint8_t in) {return ease8InOutQuad(triwave8(in));}
+LIB8STATIC uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+  uint16_t partial = (a << 8) | b;
+  partial += (b * amountOfB);
+  partial -= (a * amountOfB);
+  return partial >> 8;
+}
+LIB8STATIC uint16_t sqrt16(uint16_t x) {
+  if (x <= 1) return x;
+  uint8_t low = 1;
+  uint8_t hi = x > 7904?255:(x >> 5) + 8;
+  do {
+    uint8_t mid = (low + hi) >> 1;
+    if ((uint16_t)(mid * mid) > x) hi = mid - 1; else {if (mid == 255) return 255; low = mid + 1;}
+  } while (hi >= low);
+  return low - 1;
+}
+
+// trigonometry
+
+LIB8STATIC int16_t sin16(uint16_t theta) {
+  static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+  static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+  uint16_t offset = (theta & 0x3FFF) >> 3; // 0..2047
+  if (theta & 0x4000) offset = 2047 - offset;
+  uint8_t section = offset / 256; // 0..7
+  uint16_t b = base[section];
+  uint8_t m = slope[section];
+  uint8_t secoffset8 = (uint8_t)(offset) / 2;
+  uint16_t mx = m * secoffset8;
+  int16_t y = mx + b;
+  if (theta & 0x8000) y = -y;
+  return y;
+}
+LIB8STATIC int16_t cos16(uint16_t theta) {return sin16(theta + 16384);}
+
+LIB8STATIC uint8_t sin8(uint8_t theta) {
+  static const uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+  uint8_t offset = theta;
+  if (theta & 0x40) offset = (uint8_t)255 - offset;
+  offset &= 0x3F; // 0..63
+  uint8_t secoffset = offset & 0x0F; // 0..15
+  if (theta & 0x40) ++secoffset;
+  uint8_t section = offset >> 4; // 0..3
+  uint8_t s2 = section * 2;
+  const uint8_t *p = b_m16_interleave + s2;
+  uint8_t b = *p++;
+  uint8_t m16 = *p;
+  uint8_t mx = (m16 * secoffset) >> 4;
+  int8_t y = mx + b;
+  if (theta & 0x80) y = -y;
+  y += 128;
+  return y;
+}
+LIB8STATIC uint8_t cos8(uint8_t theta) {return sin8(theta + 64);}
+LIB8STATIC uint8_t cubicwave8(uint8_t in) {uint8_t i = triwave8(in); uint8_t ii = scale8(i, i); uint8_t iii = scale8(ii, i); uint16_t r1 = (3 * (uint16_t)ii) - (2 * (uint16_t)iii); return r1 & 0x100?255:r1;}
+
+// random, same generator as FastLED
+
+extern uint16_t rand16seed;
+#define FASTLED_RAND16_2053 ((uint16_t)(2053))
+#define FASTLED_RAND16_13849 ((uint16_t)(13849))
+LIB8STATIC uint8_t random8() {
+  rand16seed = (rand16seed * FASTLED_RAND16_2053) + FASTLED_RAND16_13849;
+  return (uint8_t)(((uint8_t)(rand16seed & 0xFF)) + ((uint8_t)(rand16seed >> 8)));
+}
+LIB8STATIC uint8_t random8(uint8_t lim) {return (random8() * lim) >> 8;}
+LIB8STATIC uint8_t random8(uint8_t min, uint8_t lim) {return random8(lim - min) + min;}
+LIB8STATIC uint16_t random16() {rand16seed = (rand16seed * FASTLED_RAND16_2053) + FASTLED_RAND16_13849; return rand16seed;}
+LIB8STATIC uint16_t random16(uint16_t lim) {return ((uint32_t)random16() * lim) >> 16;}
+LIB8STATIC uint16_t random16(uint16_t min, uint16_t lim) {return random16(lim - min) + min;}
+LIB8STATIC void random16_set_seed(uint16_t seed) {rand16seed = seed;}
+LIB8STATIC uint16_t random16_get_seed() {return rand16seed;}
+LIB8STATIC void random16_add_entropy(uint16_t entropy) {rand16seed += entropy;}
+
+// beats, based on millis() like FastLED (GET_MILLIS)
+
+LIB8STATIC uint16_t beat88(accum88 beats_per_minute_88, uint32_t timebase = 0) {return (((millis()) - timebase) * beats_per_minute_88 * 280) >> 16;}
+LIB8STATIC uint16_t beat16(accum88 beats_per_minute, uint32_t timebase = 0) {if (beats_per_minute < 256) beats_per_minute <<= 8; return beat88(beats_per_minute, timebase);}
+LIB8STATIC uint8_t beat8(accum88 beats_per_minute, uint32_t timebase = 0) {return beat16(beats_per_minute, timebase) >> 8;}
+LIB8STATIC uint8_t beatsin8(accum88 beats_per_minute, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phase_offset = 0) {
+  uint8_t beat = beat8(beats_per_minute, timebase);
+  uint8_t beatsin = sin8(beat + phase_offset);
+  uint8_t rangewidth = highest - lowest;
+  uint8_t scaledbeat = scale8(beatsin, rangewidth);
+  return lowest + scaledbeat;
+}
+LIB8STATIC uint16_t beatsin16(accum88 beats_per_minute, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase_offset = 0) {
+  uint16_t beat = beat16(beats_per_minute, timebase);
+  uint16_t beatsin = (sin16(beat + phase_offset) + 32768);
+  uint16_t rangewidth = highest - lowest;
+  uint16_t scaledbeat = scale16(beatsin, rangewidth);
+  return lowest + scaledbeat;
+}
+
+// noise: perlin gradient noise on the FastLED permutation table, 8 bit result
+
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z);
+uint8_t inoise8(uint16_t x, uint16_t y);
+uint8_t inoise8(uint16_t x);
+
+// colors
+
+struct CHSV {
+  union {
+    struct {
+      union {uint8_t hue; uint8_t h;};
+      union {uint8_t saturation; uint8_t sat; uint8_t s;};
+      union {uint8_t value; uint8_t val; uint8_t v;};
+    };
+    uint8_t raw[3];
+  };
+  CHSV(): h(0), s(0), v(0) {}
+  CHSV(uint8_t ih, uint8_t is, uint8_t iv): h(ih), s(is), v(iv) {}
+};
+
+typedef enum {
+  TypicalSMD5050 = 0xFFB0F0, TypicalLEDStrip = 0xFFB0F0, Typical8mmPixel = 0xFFE08C, TypicalPixelString = 0xFFE08C, UncorrectedColor = 0xFFFFFF
+} LEDColorCorrection;
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb);
+
+struct CRGB {
+  union {
+    struct {
+      union {uint8_t r; uint8_t red;};
+      union {uint8_t g; uint8_t green;};
+      union {uint8_t b; uint8_t blue;};
+    };
+    uint8_t raw[3];
+  };
+
+  CRGB() = default;
+  constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib): r(ir), g(ig), b(ib) {}
+  constexpr CRGB(uint32_t colorcode): r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+  CRGB(const CHSV &rhs) {hsv2rgb_rainbow(rhs, *this);}
+  CRGB &operator=(const CHSV &rhs) {hsv2rgb_rainbow(rhs, *this); return *this;}
+  CRGB &operator=(uint32_t colorcode) {r = (colorcode >> 16) & 0xFF; g = (colorcode >> 8) & 0xFF; b = colorcode & 0xFF; return *this;}
+
+  uint8_t &operator[](uint8_t x) {return raw[x];}
+  const uint8_t &operator[](uint8_t x) const {return raw[x];}
+
+  CRGB &operator+=(const CRGB &rhs) {r = qadd8(r, rhs.r); g = qadd8(g, rhs.g); b = qadd8(b, rhs.b); return *this;}
+  CRGB &operator-=(const CRGB &rhs) {r = qsub8(r, rhs.r); g = qsub8(g, rhs.g); b = qsub8(b, rhs.b); return *this;}
+  CRGB &operator|=(const CRGB &rhs) {if (rhs.r > r) r = rhs.r; if (rhs.g > g) g = rhs.g; if (rhs.b > b) b = rhs.b; return *this;}
+  CRGB &operator&=(const CRGB &rhs) {if (rhs.r < r) r = rhs.r; if (rhs.g < g) g = rhs.g; if (rhs.b < b) b = rhs.b; return *this;}
+  CRGB &operator*=(uint8_t d) {r = qmul8(r, d); g = qmul8(g, d); b = qmul8(b, d); return *this;}
+  CRGB &operator/=(uint8_t d) {r /= d; g /= d; b /= d; return *this;}
+  CRGB &operator%=(uint8_t scaledown) {return nscale8_video(scaledown);}
+
+  CRGB &nscale8(uint8_t scaledown) {r = scale8(r, scaledown); g = scale8(g, scaledown); b = scale8(b, scaledown); return *this;}
+  CRGB &nscale8_video(uint8_t scaledown) {r = scale8_video(r, scaledown); g = scale8_video(g, scaledown); b = scale8_video(b, scaledown); return *this;}
+  CRGB &fadeToBlackBy(uint8_t fadefactor) {return nscale8(255 - fadefactor);}
+  CRGB &fadeLightBy(uint8_t fadefactor) {return nscale8_video(255 - fadefactor);}
+  CRGB &setRGB(uint8_t nr, uint8_t ng, uint8_t nb) {r = nr; g = ng; b = nb; return *this;}
+  CRGB &setHSV(uint8_t hue, uint8_t sat, uint8_t val) {hsv2rgb_rainbow(CHSV(hue, sat, val), *this); return *this;}
+  CRGB &setHue(uint8_t hue) {return setHSV(hue, 255, 255);}
+  uint8_t getLuma() const {return scale8(r, 54) + scale8(g, 183) + scale8(b, 18);}
+  uint8_t getAverageLight() const {return scale8(r, 85) + scale8(g, 85) + scale8(b, 85);}
+  void maximizeBrightness(uint8_t limit = 255) {
+    uint8_t max = r; if (g > max) max = g; if (b > max) max = b;
+    if (max == 0) return;
+    uint16_t factor = ((uint16_t)(limit) * 256) / max;
+    r = (r * factor) / 256; g = (g * factor) / 256; b = (b * factor) / 256;
+  }
+
+  explicit operator bool() const {return r || g || b;}
+  explicit operator uint32_t() const {return uint32_t{0xff000000} | (uint32_t{r} << 16) | (uint32_t{g} << 8) | uint32_t{b};}
+
+  typedef enum {
+    AliceBlue=0xF0F8FF, Amethyst=0x9966CC, AntiqueWhite=0xFAEBD7, Aqua=0x00FFFF, Aquamarine=0x7FFFD4, Azure=0xF0FFFF, Beige=0xF5F5DC,
+    Bisque=0xFFE4C4, Black=0x000000, BlanchedAlmond=0xFFEBCD, Blue=0x0000FF, BlueViolet=0x8A2BE2, Brown=0xA52A2A, BurlyWood=0xDEB887,
+    CadetBlue=0x5F9EA0, Chartreuse=0x7FFF00, Chocolate=0xD2691E, Coral=0xFF7F50, CornflowerBlue=0x6495ED, Cornsilk=0xFFF8DC,
+    Crimson=0xDC143C, Cyan=0x00FFFF, DarkBlue=0x00008B, DarkCyan=0x008B8B, DarkGoldenrod=0xB8860B, DarkGray=0xA9A9A9, DarkGrey=0xA9A9A9,
+    DarkGreen=0x006400, DarkKhaki=0xBDB76B, DarkMagenta=0x8B008B, DarkOliveGreen=0x556B2F, DarkOrange=0xFF8C00, DarkOrchid=0x9932CC,
+    DarkRed=0x8B0000, DarkSalmon=0xE9967A, DarkSeaGreen=0x8FBC8F, DarkSlateBlue=0x483D8B, DarkSlateGray=0x2F4F4F, DarkTurquoise=0x00CED1,
+    DarkViolet=0x9400D3, DeepPink=0xFF1493, DeepSkyBlue=0x00BFFF, DimGray=0x696969, DimGrey=0x696969, DodgerBlue=0x1E90FF,
+    FireBrick=0xB22222, ForestGreen=0x228B22, Fuchsia=0xFF00FF, Gold=0xFFD700, Goldenrod=0xDAA520, Gray=0x808080, Grey=0x808080,
+    Green=0x008000, GreenYellow=0xADFF2F, HotPink=0xFF69B4, IndianRed=0xCD5C5C, Indigo=0x4B0082, Ivory=0xFFFFF0, Khaki=0xF0E68C,
+    Lavender=0xE6E6FA, LawnGreen=0x7CFC00, LightBlue=0xADD8E6, LightCoral=0xF08080, LightCyan=0xE0FFFF, LightGreen=0x90EE90,
+    LightPink=0xFFB6C1, LightSalmon=0xFFA07A, LightSeaGreen=0x20B2AA, LightSkyBlue=0x87CEFA, LightYellow=0xFFFFE0, Lime=0x00FF00,
+    LimeGreen=0x32CD32, Magenta=0xFF00FF, Maroon=0x800000, MediumAquamarine=0x66CDAA, MediumBlue=0x0000CD, MediumPurple=0x9370DB,
+    MediumSeaGreen=0x3CB371, MidnightBlue=0x191970, Navy=0x000080, OldLace=0xFDF5E6, Olive=0x808000, OliveDrab=0x6B8E23,
+    Orange=0xFFA500, OrangeRed=0xFF4500, Orchid=0xDA70D6, PaleGreen=0x98FB98, Pink=0xFFC0CB, Plum=0xDDA0DD, Purple=0x800080,
+    Red=0xFF0000, RoyalBlue=0x4169E1, SaddleBrown=0x8B4513, Salmon=0xFA8072, SandyBrown=0xF4A460, SeaGreen=0x2E8B57, Sienna=0xA0522D,
+    Silver=0xC0C0C0, SkyBlue=0x87CEEB, SlateBlue=0x6A5ACD, SlateGray=0x708090, Snow=0xFFFAFA, SpringGreen=0x00FF7F, SteelBlue=0x4682B4,
+    Tan=0xD2B48C, Teal=0x008080, Thistle=0xD8BFD8, Tomato=0xFF6347, Turquoise=0x40E0D0, Violet=0xEE82EE, Wheat=0xF5DEB3, White=0xFFFFFF,
+    WhiteSmoke=0xF5F5F5, Yellow=0xFFFF00, YellowGreen=0x9ACD32
+  } HTMLColorCode;
+};
+
+inline bool operator==(const CRGB &lhs, const CRGB &rhs) {return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;}
+inline bool operator!=(const CRGB &lhs, const CRGB &rhs) {return !(lhs == rhs);}
+inline bool operator<(const CRGB &lhs, const CRGB &rhs) {return (uint16_t)lhs.r + lhs.g + lhs.b < (uint16_t)rhs.r + rhs.g + rhs.b;}
+inline bool operator>(const CRGB &lhs, const CRGB &rhs) {return (uint16_t)lhs.r + lhs.g + lhs.b > (uint16_t)rhs.r + rhs.g + rhs.b;}
+inline CRGB operator+(const CRGB &p1, const CRGB &p2) {return CRGB(qadd8(p1.r, p2.r), qadd8(p1.g, p2.g), qadd8(p1.b, p2.b));}
+inline CRGB operator-(const CRGB &p1, const CRGB &p2) {return CRGB(qsub8(p1.r, p2.r), qsub8(p1.g, p2.g), qsub8(p1.b, p2.b));}
+inline CRGB operator|(const CRGB &p1, const CRGB &p2) {CRGB result = p1; result |= p2; return result;}
+inline CRGB operator&(const CRGB &p1, const CRGB &p2) {CRGB result = p1; result &= p2; return result;}
+inline CRGB operator*(const CRGB &p1, uint8_t d) {return CRGB(qmul8(p1.r, d), qmul8(p1.g, d), qmul8(p1.b, d));}
+inline CRGB operator/(const CRGB &p1, uint8_t d) {return CRGB(p1.r / d, p1.g / d, p1.b / d);}
+inline CRGB operator%(const CRGB &p1, uint8_t d) {CRGB result = p1; result.nscale8_video(d); return result;}
+
+CHSV rgb2hsv_approximate(const CRGB &rgb);
+CRGB HeatColor(uint8_t temperature);
+
+LIB8STATIC CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2) {
+  return CRGB(blend8(p1.r, p2.r, amountOfP2), blend8(p1.g, p2.g, amountOfP2), blend8(p1.b, p2.b, amountOfP2));
+}
+LIB8STATIC CRGB &nblend(CRGB &existing, const CRGB &overlay, fract8 amountOfOverlay) {
+  existing = blend(existing, overlay, amountOfOverlay);
+  return existing;
+}
+
+void fill_solid(CRGB *targetArray, int numToFill, const CRGB &color);
+void fill_rainbow(CRGB *targetArray, int numToFill, uint8_t initialhue, uint8_t deltahue = 5);
+void fadeToBlackBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy);
+void nscale8(CRGB *leds, uint16_t num_leds, uint8_t scale);
+void blur1d(CRGB *leds, uint16_t numLeds, fract8 blur_amount);
+
+// palettes
+
+typedef uint32_t TProgmemRGBPalette16[16];
+typedef enum {NOBLEND = 0, LINEARBLEND = 1, LINEARBLEND_NOWRAP = 2} TBlendType;
+
+class CRGBPalette16 {
+public:
+  CRGB entries[16];
+  CRGBPalette16() {memset(entries, 0, sizeof(entries));}
+  CRGBPalette16(const TProgmemRGBPalette16 &rhs) {*this = rhs;}
+  CRGBPalette16 &operator=(const TProgmemRGBPalette16 &rhs) {
+    for (uint8_t i = 0; i < 16; ++i) entries[i] = CRGB(rhs[i]);
+    return *this;
+  }
+  CRGB &operator[](uint8_t x) {return entries[x];}
+  const CRGB &operator[](uint8_t x) const {return entries[x];}
+  bool operator==(const CRGBPalette16 &rhs) const {return memcmp(entries, rhs.entries, sizeof(entries)) == 0;}
+  bool operator!=(const CRGBPalette16 &rhs) const {return !(*this == rhs);}
+};
+
+CRGB ColorFromPalette(const CRGBPalette16 &pal, uint8_t index, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND);
+
+extern const TProgmemRGBPalette16 CloudColors_p;
+extern const TProgmemRGBPalette16 LavaColors_p;
+extern const TProgmemRGBPalette16 OceanColors_p;
+extern const TProgmemRGBPalette16 ForestColors_p;
+extern const TProgmemRGBPalette16 RainbowColors_p;
+extern const TProgmemRGBPalette16 RainbowStripeColors_p;
+extern const TProgmemRGBPalette16 PartyColors_p;
+extern const TProgmemRGBPalette16 HeatColors_p;
+
+// controller: no hardware, show is a no-op
+
+class CLEDController {
+public:
+  CLEDController &setCorrection(LEDColorCorrection correction) {return *this;}
+  CLEDController &setCorrection(CRGB correction) {return *this;}
+  CLEDController &setDither(uint8_t ditherMode) {return *this;}
+};
+
+template <uint8_t DATA_PIN> class NEOPIXEL {};
+template <uint8_t DATA_PIN> class WS2812 {};
+template <uint8_t DATA_PIN> class WS2812B {};
+template <uint8_t DATA_PIN> class SK6812 {};
+
+class CFastLED {
+public:
+  template <template <uint8_t DATA_PIN> class CHIPSET, uint8_t DATA_PIN>
+  CLEDController &addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset = 0) {return controller;}
+
+  void setBrightness(uint8_t scale) {brightness = scale;}
+  uint8_t getBrightness() {return brightness;}
+  void setMaxPowerInMilliWatts(uint32_t milliwatts) {}
+  void setMaxRefreshRate(uint16_t refresh, bool constrain = false) {}
+  void show() {}
+  void show(uint8_t scale) {}
+  void clear(bool writeData = false) {}
+  void delay(unsigned long ms) {::delay(ms);}
+  uint16_t getFPS() {return 0;}
+
+private:
+  uint8_t brightness = 255;
+  CLEDController controller;
+};
+
+extern CFastLED FastLED;
@@ -0,0 +1,34 @@
+/*
+   @title     StarLight
+   @file      HardwareSerial.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+//Serial writes to stdout, nothing to read
+class HardwareSerial: public Stream {
+public:
+  void begin(unsigned long baud, uint32_t config = 0, int8_t rxPin = -1, int8_t txPin = -1) {}
+  void end() {}
+  void setDebugOutput(bool) {}
+  operator bool() const {return true;}
+
+  size_t write(uint8_t c) override {return fputc(c, stdout) == EOF?0:1;}
+  size_t write(const uint8_t *buffer, size_t size) override {return fwrite(buffer, 1, size, stdout);}
+  using Print::write;
+  void flush() override {fflush(stdout);}
+
+  int available() override {return 0;}
+  int read() override {return -1;}
+  int peek() override {return -1;}
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,42 @@
+/*
+   @title     StarLight
+   @file      IPAddress.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+class IPAddress {
+public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d): bytes{a, b, c, d} {}
+  IPAddress(uint32_t address) {memcpy(bytes, &address, 4);}
+
+  operator uint32_t() const {uint32_t address; memcpy(&address, bytes, 4); return address;}
+  bool operator==(const IPAddress &rhs) const {return memcmp(bytes, rhs.bytes, 4) == 0;}
+  bool operator!=(const IPAddress &rhs) const {return !(*this == rhs);}
+  uint8_t operator[](int index) const {return bytes[index];}
+  uint8_t &operator[](int index) {return bytes[index];}
+
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return String(buf);
+  }
+  bool fromString(const char *address) {
+    unsigned a, b, c, d;
+    if (sscanf(address, "%u.%u.%u.%u", &a, &b, &c, &d) != 4) return false;
+    *this = IPAddress(a, b, c, d);
+    return true;
+  }
+
+private:
+  uint8_t bytes[4] = {0, 0, 0, 0};
+};
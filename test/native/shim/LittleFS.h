@@ -0,0 +1,170 @@
+/*
+   @title     StarLight
+   @file      LittleFS.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+#include <memory>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//LittleFS on a host directory (flat, like the StarBase file system), default ./native_fs relative to the working dir
+
+#ifndef STARBASE_NATIVE_FS_ROOT
+  #define STARBASE_NATIVE_FS_ROOT "native_fs"
+#endif
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+class File: public Stream {
+public:
+  File() {}
+
+  static File openPath(const std::string &hostPath, const std::string &path, const char *mode) {
+    File file;
+    struct stat st;
+    if (stat(hostPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+      file.impl = std::make_shared<Impl>();
+      file.impl->isDir = true;
+      DIR *dir = opendir(hostPath.c_str());
+      if (dir) {
+        while (struct dirent *entry = readdir(dir)) {
+          if (entry->d_name[0] != '.') file.impl->entries.push_back(entry->d_name);
+        }
+        closedir(dir);
+      }
+      std::sort(file.impl->entries.begin(), file.impl->entries.end()); //deterministic order for seqNr lookups
+    }
+    else {
+      FILE *fp = fopen(hostPath.c_str(), strcmp(mode, FILE_WRITE) == 0?"wb":strcmp(mode, FILE_APPEND) == 0?"ab":"rb");
+      if (!fp) return file;
+      file.impl = std::make_shared<Impl>();
+      file.impl->fp = fp;
+    }
+    file.impl->hostPath = hostPath;
+    file.impl->path = path;
+    return file;
+  }
+
+  operator bool() const {return impl != nullptr && (impl->isDir || impl->fp != nullptr);}
+
+  size_t write(uint8_t c) override {return (impl && impl->fp && fputc(c, impl->fp) != EOF)?1:0;}
+  size_t write(const uint8_t *buffer, size_t size) override {return (impl && impl->fp)?fwrite(buffer, 1, size, impl->fp):0;}
+  using Print::write;
+
+  int available() override {
+    if (!impl || !impl->fp) return 0;
+    long pos = ftell(impl->fp);
+    return pos < 0?0:(int)(size() - pos);
+  }
+  int read() override {return (impl && impl->fp)?fgetc(impl->fp):-1;}
+  size_t read(uint8_t *buffer, size_t size) {return (impl && impl->fp)?fread(buffer, 1, size, impl->fp):0;}
+  int peek() override {
+    if (!impl || !impl->fp) return -1;
+    int c = fgetc(impl->fp);
+    if (c != EOF) ungetc(c, impl->fp);
+    return c;
+  }
+  bool seek(uint32_t pos) {return impl && impl->fp && fseek(impl->fp, pos, SEEK_SET) == 0;}
+  size_t position() {return (impl && impl->fp)?ftell(impl->fp):0;}
+  void flush() override {if (impl && impl->fp) fflush(impl->fp);}
+
+  size_t size() const {
+    if (!impl) return 0;
+    if (impl->fp) fflush(impl->fp);
+    struct stat st;
+    return stat(impl->hostPath.c_str(), &st) == 0?st.st_size:0;
+  }
+  time_t getLastWrite() const {
+    struct stat st;
+    return (impl && stat(impl->hostPath.c_str(), &st) == 0)?st.st_mtime:0;
+  }
+  //like esp32 LittleFS: name without directory, path with
+  const char *name() const {
+    if (!impl) return "";
+    size_t slash = impl->path.find_last_of('/');
+    return impl->path.c_str() + (slash == std::string::npos?0:slash + 1);
+  }
+  const char *path() const {return impl?impl->path.c_str():"";}
+  bool isDirectory() const {return impl && impl->isDir;}
+
+  File openNextFile(const char *mode = FILE_READ) {
+    if (!impl || !impl->isDir || impl->nextEntry >= impl->entries.size()) return File();
+    const std::string &entry = impl->entries[impl->nextEntry++];
+    std::string path = impl->path == "/"?"/" + entry:impl->path + "/" + entry;
+    return openPath(impl->hostPath + "/" + entry, path, mode);
+  }
+
+  void close() {
+    if (impl && impl->fp) {fclose(impl->fp); impl->fp = nullptr;}
+    impl = nullptr;
+  }
+
+private:
+  struct Impl {
+    FILE *fp = nullptr;
+    bool isDir = false;
+    std::string hostPath;
+    std::string path;
+    std::vector<std::string> entries;
+    size_t nextEntry = 0;
+    ~Impl() {if (fp) fclose(fp);}
+  };
+  std::shared_ptr<Impl> impl;
+};
+
+class LittleFSFS {
+public:
+  bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10, const char *partitionLabel = "spiffs") {
+    mkdir(STARBASE_NATIVE_FS_ROOT, 0755);
+    struct stat st;
+    return stat(STARBASE_NATIVE_FS_ROOT, &st) == 0 && S_ISDIR(st.st_mode);
+  }
+  void end() {}
+  bool format() {
+    File root = open("/");
+    for (File file = root.openNextFile(); file; file = root.openNextFile()) remove(file.path());
+    return true;
+  }
+
+  File open(const char *path, const char *mode = FILE_READ, const bool create = false) {
+    return File::openPath(hostPath(path), path, mode);
+  }
+  bool exists(const char *path) {
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+  }
+  bool remove(const char *path) {return ::remove(hostPath(path).c_str()) == 0;}
+  bool rename(const char *pathFrom, const char *pathTo) {return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;}
+
+  size_t totalBytes() {return 1408 * 1024;} //as the default esp32 partition
+  size_t usedBytes() {
+    size_t used = 0;
+    File root = open("/");
+    for (File file = root.openNextFile(); file; file = root.openNextFile()) used += file.size();
+    return used;
+  }
+
+private:
+  std::string hostPath(const char *path) {
+    std::string result = STARBASE_NATIVE_FS_ROOT;
+    if (path[0] != '/') result += "/";
+    result += path;
+    while (result.size() > 1 && result.back() == '/') result.pop_back();
+    return result;
+  }
+};
+
+extern LittleFSFS LittleFS;
@@ -0,0 +1,34 @@
+/*
+   @title     StarLight
+   @file      WiFi.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+#include "WiFiUdp.h"
+
+typedef enum {WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_DISCONNECTED = 6} wl_status_t;
+typedef enum {WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3} wifi_mode_t;
+
+//host is never connected
+class WiFiClass {
+public:
+  wl_status_t status() {return WL_DISCONNECTED;}
+  IPAddress localIP() {return IPAddress();}
+  IPAddress softAPIP() {return IPAddress();}
+  String macAddress() {return String("00:00:00:00:00:00");}
+  uint8_t *macAddress(uint8_t *mac) {memset(mac, 0, 6); return mac;}
+  int8_t RSSI() {return 0;}
+  bool mode(wifi_mode_t) {return true;}
+  wifi_mode_t getMode() {return WIFI_OFF;}
+  bool disconnect(bool wifiOff = false) {return true;}
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,39 @@
+/*
+   @title     StarLight
+   @file      WiFiUdp.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+//no network on the host: nothing is received, everything send is dropped
+class WiFiUDP: public Stream {
+public:
+  uint8_t begin(uint16_t port) {return 1;}
+  uint8_t beginMulticast(IPAddress multicast, uint16_t port) {return 1;}
+  void stop() {}
+  int beginPacket(IPAddress ip, uint16_t port) {return 1;}
+  int beginPacket(const char *host, uint16_t port) {return 1;}
+  int endPacket() {return 1;}
+  int parsePacket() {return 0;}
+  IPAddress remoteIP() {return IPAddress();}
+  uint16_t remotePort() {return 0;}
+
+  size_t write(uint8_t c) override {return 1;}
+  size_t write(const uint8_t *buffer, size_t size) override {return size;}
+  using Print::write;
+
+  int available() override {return 0;}
+  int read() override {return -1;}
+  int read(uint8_t *buffer, size_t len) {return 0;}
+  int read(char *buffer, size_t len) {return 0;}
+  int peek() override {return -1;}
+  void flush() override {}
+};
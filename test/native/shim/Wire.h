@@ -0,0 +1,27 @@
+/*
+   @title     StarLight
+   @file      Wire.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) {return true;}
+  void beginTransmission(uint8_t address) {}
+  uint8_t endTransmission(bool sendStop = true) {return 2;} //2: nack, no device on the host
+  size_t requestFrom(uint8_t address, size_t size, bool sendStop = true) {return 0;}
+  size_t write(uint8_t c) {return 1;}
+  int available() {return 0;}
+  int read() {return -1;}
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,21 @@
+/*
+   @title     StarLight
+   @file      esp_wifi.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+typedef enum {WIFI_IF_STA = 0, WIFI_IF_AP = 1} wifi_interface_t;
+
+inline esp_err_t esp_wifi_get_mac(wifi_interface_t ifx, uint8_t mac[6]) {memset(mac, 0, 6); return ESP_OK;}
@@ -0,0 +1,227 @@
+/*
+   @title     StarLight
+   @file      test_artnet.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// Art-Net packets over host loopback UDP: pio test -e native -f test_artnet -v
+// a receiver reassembles the frame from the universes of the outputs until the ArtSync and checks the header of each packet
+
+#include <unity.h>
+
+#include "Sys/SysModUI.h" //ui and the model, used by the modules
+#include "Sys/SysModInstances.h" //net, sys and mdls
+#include "App/LedModEffects.h"
+#include "App/LedModFixture.h"
+#include "User/UserModArtNet.h"
+#include "../native/Loopback.h"
+
+static CRGB leds[TEST_NR_OF_LEDS];
+static uint8_t lut[3][256];
+static uint8_t frame[TEST_NR_OF_LEDS * sizeof(CRGB)];
+
+static std::vector<ArtNetUniverse> universes;
+static std::vector<uint8_t> packets;
+static std::vector<ArtNetNode> nodes;
+
+static int sender = -1;
+static int receiver = -1;
+static sockaddr_in receiverAddress;
+
+void setUp() {
+  fillTestLeds(leds, TEST_NR_OF_LEDS);
+  fillTestLut(lut);
+}
+
+void tearDown() {}
+
+//two outputs: leds 0..1199 from universe 0 (net 0 subnet 0) and leds 1200..1999 from net 1 subnet 2 universe 3
+static void makeUniverses(bool pack512) {
+  universes.clear();
+  artnetAddOutput(universes, 0, 1200, 0, 11, pack512);
+  artnetAddOutput(universes, 1200, 800, 0x123, 11, pack512);
+  artnetMakePackets(universes, packets, nodes);
+}
+
+static size_t sendFrame(uint8_t sequenceNumber) {
+  for (const ArtNetUniverse &universe: universes) {
+    uint8_t *packet = packets.data() + universe.packetOffset;
+    size_t packetLength = artnetData(packet, leds, sizeof(frame), universe, sequenceNumber, lut);
+    loopbackSend(sender, receiverAddress, packet, packetLength);
+  }
+  uint8_t syncPacket[ARTNET_SYNC_SIZE];
+  loopbackSend(sender, receiverAddress, syncPacket, artsyncPacket(syncPacket));
+  return universes.size();
+}
+
+//receive until the ArtSync, check each header and copy the data to frame at the channel of its port address, returns nr of ArtDmx packets
+static size_t receiveFrame(uint8_t sequenceNumber) {
+  uint8_t received[1500];
+  size_t packetCount = 0;
+  bool sync = false;
+  while (!sync) {
+    ssize_t len = recv(receiver, received, sizeof(received), 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(ARTNET_SYNC_SIZE, len);
+    TEST_ASSERT_EQUAL_STRING("Art-Net", (const char *)received);
+    TEST_ASSERT_EQUAL(14, received[11]);
+
+    uint16_t opCode = received[8] | (received[9] << 8);
+    sync = opCode == 0x5200;
+    if (sync) {
+      TEST_ASSERT_EQUAL(ARTNET_SYNC_SIZE, len);
+      continue;
+    }
+    TEST_ASSERT_EQUAL_HEX16(0x5000, opCode);
+    TEST_ASSERT_EQUAL(sequenceNumber, received[12]);
+
+    uint16_t portAddress = received[14] | (received[15] << 8);
+    uint16_t dataLength = (received[16] << 8) | received[17];
+    TEST_ASSERT_EQUAL(len - ARTNET_HEADER_SIZE, dataLength);
+    TEST_ASSERT_LESS_OR_EQUAL(ARTNET_MAX_CHANNELS, dataLength);
+    TEST_ASSERT_EQUAL(0, dataLength & 1);
+
+    //the universe of the port address
+    const ArtNetUniverse *universe = nullptr;
+    for (const ArtNetUniverse &u: universes) if (u.portAddress == portAddress) universe = &u;
+    TEST_ASSERT_NOT_NULL(universe);
+    TEST_ASSERT_EQUAL(universe->length(), dataLength);
+
+    memcpy(frame + universe->channel, received + ARTNET_HEADER_SIZE, universe->channels);
+    packetCount++;
+  }
+  return packetCount;
+}
+
+//510: 170 leds per universe, 512: leds split over universes
+void test_artnet_layout() {
+  for (bool pack512: {false, true}) {
+    makeUniverses(pack512);
+    memset(frame, 0, sizeof(frame));
+
+    //1200 leds = 3600 channels: 8 universes of 510 (last 30) or 8 of 512 (last 16), 800 leds = 2400 channels: 5 of 510 (last 360) or 5 of 512 (last 352)
+    TEST_ASSERT_EQUAL(13, universes.size());
+    TEST_ASSERT_EQUAL(pack512?16:30, universes[7].channels);
+    TEST_ASSERT_EQUAL_HEX16(0x007, universes[7].portAddress);
+    TEST_ASSERT_EQUAL_HEX16(0x123, universes[8].portAddress);
+    TEST_ASSERT_EQUAL_HEX16(0x127, universes[12].portAddress);
+    TEST_ASSERT_EQUAL(1200 * 3, universes[8].channel);
+
+    size_t sent = sendFrame(1);
+    TEST_ASSERT_EQUAL(sent, receiveFrame(1));
+    TEST_ASSERT_EQUAL_MEMORY(&leds[0].r, frame, sizeof(frame));
+  }
+}
+
+//512 channels per universe: a led split over universes continues with the lut of its next channel
+void test_artnet_lut() {
+  for (int i = 0; i < 256; i++) {
+    lut[0][i] = scale8(i, 128);
+    lut[1][i] = scale8(i, 64);
+    lut[2][i] = 255 - i;
+  }
+  makeUniverses(true);
+
+  sendFrame(2);
+  receiveFrame(2);
+  for (int i = 0; i < TEST_NR_OF_LEDS; i++) {
+    TEST_ASSERT_EQUAL(scale8(leds[i].r, 128), frame[i * 3]);
+    TEST_ASSERT_EQUAL(scale8(leds[i].g, 64), frame[i * 3 + 1]);
+    TEST_ASSERT_EQUAL(255 - leds[i].b, frame[i * 3 + 2]);
+  }
+}
+
+//channels of an output beyond the leds are send as 0
+void test_artnet_beyond_leds() {
+  std::vector<ArtNetUniverse> beyond;
+  artnetAddOutput(beyond, TEST_NR_OF_LEDS - 10, 20, 0, 11, false);
+  TEST_ASSERT_EQUAL(1, beyond.size());
+  TEST_ASSERT_EQUAL(60, beyond[0].length());
+
+  uint8_t packet[ARTNET_HEADER_SIZE + ARTNET_MAX_CHANNELS];
+  memset(packet, 0xFF, sizeof(packet));
+  artnetHeader(packet, beyond[0]);
+  TEST_ASSERT_EQUAL(ARTNET_HEADER_SIZE + 60, artnetData(packet, leds, sizeof(frame), beyond[0], 1, lut));
+  TEST_ASSERT_EQUAL_MEMORY(&leds[TEST_NR_OF_LEDS - 10].r, packet + ARTNET_HEADER_SIZE, 30);
+  for (int i = 30; i < 60; i++) TEST_ASSERT_EQUAL(0, packet[ARTNET_HEADER_SIZE + i]);
+}
+
+//frames of 3 nodes every frameMillis during 5 s, returns the nr of frames send to each node
+static size_t nodeFrames(std::vector<ArtNetNode> &rated, unsigned long frameMillis, uint16_t maxFps, size_t sendCount[3]) {
+  for (ArtNetNode &node: rated) node.lastMillis = 0;
+  size_t frames = 0;
+  for (unsigned long now = 1000; now < 6000; now += frameMillis) {
+    if (artnetNodesDue(rated, now, maxFps)) frames++;
+    for (size_t i = 0; i < rated.size(); i++) sendCount[i] += rated[i].send;
+  }
+  return frames;
+}
+
+//per node at most maxFps, frames slightly faster than maxFps are not halved, node 0 (targetIP not set) is never send to
+void test_artnet_rate_limit() {
+  std::vector<ArtNetUniverse> rated;
+  artnetAddOutput(rated, 0, 170, 0, 11, false);
+  artnetAddOutput(rated, 170, 340, 1, 12, false);
+  artnetAddOutput(rated, 510, 170, 3, 0, false);
+  std::vector<uint8_t> ratedPackets;
+  std::vector<ArtNetNode> ratedNodes;
+  artnetMakePackets(rated, ratedPackets, ratedNodes);
+  TEST_ASSERT_EQUAL(3, ratedNodes.size());
+  TEST_ASSERT_EQUAL(4 * (ARTNET_HEADER_SIZE + 510), ratedPackets.size());
+  TEST_ASSERT_EQUAL(2 * (ARTNET_HEADER_SIZE + 510), rated[2].packetOffset); //second universe of node 12
+
+  size_t sendCount[3] = {0, 0, 0};
+  TEST_ASSERT_EQUAL(227, nodeFrames(ratedNodes, 20, 44, sendCount)); //50 fps: 1000 / 22 ms period
+  TEST_ASSERT_EQUAL(227, sendCount[0]);
+  TEST_ASSERT_EQUAL(227, sendCount[1]);
+  TEST_ASSERT_EQUAL(0, sendCount[2]);
+
+  memset(sendCount, 0, sizeof(sendCount));
+  TEST_ASSERT_EQUAL(228, nodeFrames(ratedNodes, 5, 44, sendCount)); //200 fps
+  TEST_ASSERT_EQUAL(228, sendCount[0]);
+
+  memset(sendCount, 0, sizeof(sendCount));
+  TEST_ASSERT_EQUAL(100, nodeFrames(ratedNodes, 50, 44, sendCount)); //20 fps: every frame
+  memset(sendCount, 0, sizeof(sendCount));
+  TEST_ASSERT_EQUAL(1000, nodeFrames(ratedNodes, 5, 0, sendCount)); //no limit
+  TEST_ASSERT_EQUAL(0, sendCount[2]);
+}
+
+//packet building only, then including loopback send and receive
+void test_artnet_throughput() {
+  makeUniverses(false);
+
+  frameThroughput("artnet", "build", [](int frameNr, size_t &bytes) {
+    for (const ArtNetUniverse &universe: universes)
+      bytes += artnetData(packets.data() + universe.packetOffset, leds, sizeof(frame), universe, 1, lut);
+    return universes.size();
+  });
+
+  size_t packetCount = frameThroughput("artnet", "loopback", [](int frameNr, size_t &bytes) {
+    sendFrame(frameNr % 255 + 1);
+    bytes += sizeof(frame);
+    return receiveFrame(frameNr % 255 + 1);
+  });
+  TEST_ASSERT_EQUAL(TEST_FRAMES * universes.size(), packetCount);
+}
+
+int main(int argc, char **argv) {
+  receiver = loopbackReceiver(receiverAddress);
+  sender = socket(AF_INET, SOCK_DGRAM, 0);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_artnet_layout);
+  RUN_TEST(test_artnet_lut);
+  RUN_TEST(test_artnet_beyond_leds);
+  RUN_TEST(test_artnet_rate_limit);
+  RUN_TEST(test_artnet_throughput);
+  int result = UNITY_END();
+
+  close(sender);
+  close(receiver);
+  return result;
+}
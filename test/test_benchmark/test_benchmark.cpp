@@ -0,0 +1,298 @@
+/*
+   @title     StarLight
+   @file      test_benchmark.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// Render benchmark for the native env: pio test -e native -f test_benchmark -v
+// parses the generated fixtures with StarJson and reports MB/s
+// runs every effect x projection x fixture size on layer 0 and reports mapping time, fps and µs/frame
+// blends a layer buffer on ledsP per blend mode (the compositor of overlapping layers) and reports µs/frame
+// maps and renders a fixture with all log categories off and at their highest level (output to Serial, discarded) and reports the cost of logging
+// host timings are not esp32 timings: compare runs with each other to catch regressions
+
+#include <unity.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "SysModule.h"
+#include "SysModules.h"
+#include "Sys/SysModPrint.h"
+#include "Sys/SysModWeb.h"
+#include "Sys/SysModUI.h"
+#include "Sys/SysModSystem.h"
+#include "Sys/SysModFiles.h"
+#include "Sys/SysModModel.h"
+#include "Sys/SysModPins.h"
+#include "Sys/SysModInstances.h"
+#include "Sys/SysStarJson.h"
+#include "App/LedModEffects.h"
+#include "App/LedModFixture.h"
+#include "App/LedModFixtureGen.h"
+
+#ifndef BENCHMARK_FRAMES
+  #define BENCHMARK_FRAMES 50
+#endif
+#define BENCHMARK_WARMUP 5
+#define BENCHMARK_BLEND_LEDS 16384
+
+struct BenchFixture {
+  const char * name;
+  uint16_t width;
+  uint16_t height;
+};
+
+static const BenchFixture benchFixtures[] = {
+  {"F_Bench16x16", 16, 16},
+  {"F_Bench32x32", 32, 32},
+  {"F_Bench64x64", 64, 64},
+  {"F_Bench128x64", 128, 64},
+};
+
+//same modules and order as main.cpp, without network, instances (constructed for changedVarsQueue only) and fixture generator
+static void setupModules() {
+  mdls = new SysModules();
+
+  print = new SysModPrint();
+  files = new SysModFiles();
+  mdl = new SysModModel();
+  web = new SysModWeb();
+  ui = new SysModUI();
+  sys = new SysModSystem();
+  pinsM = new SysModPins();
+  instances = new SysModInstances();
+  eff = new LedModEffects();
+  fix = new LedModFixture();
+
+  mdls->add(fix);
+  mdls->add(eff);
+  mdls->add(files);
+  mdls->add(sys);
+  mdls->add(pinsM);
+  mdls->add(print);
+  mdls->add(web);
+  mdls->add(mdl);
+  mdls->add(ui);
+
+  mdls->setup();
+
+  //silence ppf, benchmark results are printed with printf
+  mdls->isConnected = true;
+  mdl->setValue("Print", "output", (uint8_t)0);
+}
+
+//panel, not serpentine, 1 pin
+static void generateFixture(const BenchFixture &benchFixture) {
+  GenFix genFix;
+  genFix.factor = 1;
+  genFix.openHeader("%s", benchFixture.name);
+  genFix.matrix(Coord3D{0, 0, 0}, Coord3D{benchFixture.width - 1, 0, 0}, Coord3D{benchFixture.width - 1, benchFixture.height - 1, 0}, 0, 16);
+  genFix.closeHeader();
+}
+
+//run mapping now instead of waiting for LedModFixture::loop (max once per second)
+static unsigned long doMapping() {
+  unsigned long start = micros();
+  while (fix->mappingStatus == 1)
+    fix->mapInitAlloc();
+  unsigned long elapsed = micros() - start;
+
+  web->sendResponseObject();
+  instances->changedVarsQueue.clear();
+  return elapsed;
+}
+
+static void renderFrame() {
+  sys->now = millis();
+  eff->loop();
+  fix->loop();
+}
+
+void test_fixtures_generated() {
+  for (const BenchFixture &benchFixture: benchFixtures) {
+    generateFixture(benchFixture);
+
+    char fileName[32];
+    print->fFormat(fileName, sizeof(fileName), "/%s.json", benchFixture.name);
+    size_t seqNr;
+    TEST_ASSERT_TRUE(files->nameToSeqNr(fileName, &seqNr, "F_"));
+  }
+}
+
+//the json walk of mapInitAlloc pass 1, without the mapping
+void test_starjson_benchmark() {
+  printf("starjson;fixture;bytes;leds;µs;MB/s\n");
+
+  for (const BenchFixture &benchFixture: benchFixtures) {
+    char fileName[32];
+    print->fFormat(fileName, sizeof(fileName), "/%s.json", benchFixture.name);
+
+    File f = files->open(fileName, FILE_READ);
+    TEST_ASSERT_TRUE(f);
+    size_t fileSize = f.size();
+    f.close();
+
+    uint8_t ledFactor, ledSize, ledShape, pin;
+    size_t nrOfLeds = 0;
+
+    unsigned long start = micros();
+    StarJson starJson(fileName);
+    starJson.lookFor("factor", &ledFactor);
+    starJson.lookFor("ledSize", &ledSize);
+    starJson.lookFor("shape", &ledShape);
+    starJson.lookFor("pin", &pin);
+    starJson.lookFor("leds", [&nrOfLeds](const std::vector<uint16_t> &uint16CollectList) {
+      if (uint16CollectList.size() >= 1) nrOfLeds++;
+    });
+    TEST_ASSERT_TRUE(starJson.deserialize());
+    unsigned long elapsed = max(micros() - start, 1UL);
+
+    TEST_ASSERT_EQUAL(benchFixture.width * benchFixture.height, nrOfLeds);
+
+    printf("starjson;%s;%d;%d;%lu;%.2f\n", benchFixture.name, fileSize, nrOfLeds, elapsed, (float)fileSize / elapsed); //bytes per µs = MB/s
+  }
+  fflush(stdout);
+}
+
+void test_render_benchmark() {
+  fix->fps = UINT16_MAX; //no frame pacing: every loop is a new frame
+
+  printf("bench;fixture;leds;effect;projection;map µs;fps;µs/frame\n");
+
+  for (const BenchFixture &benchFixture: benchFixtures) {
+    char fileName[32];
+    print->fFormat(fileName, sizeof(fileName), "/%s.json", benchFixture.name);
+    size_t seqNr;
+    TEST_ASSERT_TRUE(files->nameToSeqNr(fileName, &seqNr, "F_"));
+
+    mdl->setValue("Fixture", "fixture", (uint8_t)seqNr);
+    doMapping();
+    TEST_ASSERT_EQUAL(0, fix->mappingStatus);
+    TEST_ASSERT_EQUAL(benchFixture.width * benchFixture.height, fix->nrOfLeds);
+
+    for (uint8_t projectionNr = 0; projectionNr < eff->projections.size(); projectionNr++) {
+      mdl->setValue("layers", "projection", projectionNr, 0);
+      const char * projectionName = fix->layers[0]->projection?fix->layers[0]->projection->name():"None";
+
+      for (uint8_t effectNr = 0; effectNr < eff->effects.size(); effectNr++) {
+        mdl->setValue("layers", "effect", effectNr, 0);
+        fix->layers[0]->triggerMapping(); //also remap if the effect dimension did not change, to time each combination
+        unsigned long mapMicros = doMapping();
+        TEST_ASSERT_EQUAL(0, fix->mappingStatus);
+
+        for (int frame = 0; frame < BENCHMARK_WARMUP; frame++) renderFrame();
+
+        unsigned long start = micros();
+        for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) renderFrame();
+        unsigned long elapsed = max(micros() - start, 1UL);
+
+        web->sendResponseObject();
+        instances->changedVarsQueue.clear();
+
+        printf("bench;%s;%d;%s;%s;%lu;%lu;%lu\n", benchFixture.name, fix->nrOfLeds, fix->layers[0]->effect->name(), projectionName, mapMicros, BENCHMARK_FRAMES * 1000000UL / elapsed, elapsed / BENCHMARK_FRAMES);
+      }
+    }
+    fflush(stdout);
+  }
+}
+
+//all pixels of a layer shared with the layer before: the worst case of LedModFixture::compositeLayers (slot i is pixel i)
+void test_blend_benchmark() {
+  static const char * blendModeNames[] = {"Normal", "Add", "Lighten", "Multiply", "Screen", "Subtract"};
+  static_assert(sizeof(blendModeNames) / sizeof(blendModeNames[0]) == bm_count, "a name per blend mode");
+
+  //one pixel per mode: (200,10,255) blended with (100,10,255)
+  const CRGB expected[bm_count] = {CRGB(150,10,255), CRGB(255,20,255), CRGB(200,10,255), CRGB(78,0,255), CRGB(222,20,255), CRGB(100,0,0)};
+  for (uint8_t blendMode = 0; blendMode < bm_count; blendMode++) {
+    CRGB dst = CRGB(200,10,255);
+    const CRGB src = CRGB(100,10,255);
+    const uint16_t index = 0;
+    blendPixels(&dst, &index, &src, &index, 1, blendMode, 128);
+    TEST_ASSERT_EQUAL_MESSAGE(expected[blendMode].r, dst.r, blendModeNames[blendMode]);
+    TEST_ASSERT_EQUAL_MESSAGE(expected[blendMode].g, dst.g, blendModeNames[blendMode]);
+    TEST_ASSERT_EQUAL_MESSAGE(expected[blendMode].b, dst.b, blendModeNames[blendMode]);
+  }
+
+  std::vector<CRGB> dst(BENCHMARK_BLEND_LEDS), src(BENCHMARK_BLEND_LEDS);
+  std::vector<uint16_t> indexes(BENCHMARK_BLEND_LEDS);
+  for (int i = 0; i < BENCHMARK_BLEND_LEDS; i++) {
+    dst[i] = CRGB(i, i >> 3, i * 7);
+    src[i] = CRGB(i * 3, i >> 2, i);
+    indexes[i] = i;
+  }
+
+  printf("blend;mode;leds;µs/frame\n");
+  for (uint8_t blendMode = 0; blendMode < bm_count; blendMode++) {
+    unsigned long start = micros();
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
+      blendPixels(dst.data(), indexes.data(), src.data(), indexes.data(), BENCHMARK_BLEND_LEDS, blendMode, 128);
+    unsigned long elapsed = max(micros() - start, 1UL);
+    printf("blend;%s;%d;%lu\n", blendModeNames[blendMode], BENCHMARK_BLEND_LEDS, elapsed / BENCHMARK_FRAMES);
+  }
+  fflush(stdout);
+}
+
+//ppfE .. ppfV above STARBASE_LOG_LEVEL are not compiled, the others cost a level check if off: compare with -D STARBASE_LOG_LEVEL=5
+void test_log_benchmark() {
+  char fileName[32];
+  print->fFormat(fileName, sizeof(fileName), "/%s.json", "F_Bench64x64");
+  size_t seqNr;
+  TEST_ASSERT_TRUE(files->nameToSeqNr(fileName, &seqNr, "F_"));
+  mdl->setValue("Fixture", "fixture", (uint8_t)seqNr);
+  mdl->setValue("layers", "projection", (uint8_t)0, 0);
+  mdl->setValue("layers", "effect", (uint8_t)0, 0);
+  doMapping();
+
+  const uint8_t savedOutput = print->output;
+  uint8_t savedLogLevels[lc_count];
+  memcpy(savedLogLevels, print->logLevels, sizeof(savedLogLevels));
+
+  printf("log;build level;levels;map µs;µs/frame\n");
+  fflush(stdout);
+
+  for (uint8_t level: {LOG_OFF, LOG_VERBOSE}) {
+    memset(print->logLevels, level, sizeof(print->logLevels));
+    mdl->setValue("Print", "output", (uint8_t)(level?1:0)); //1: Serial
+
+    //Serial is stdout on native: discard the log lines, not the results
+    int savedStdout = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    dup2(devNull, STDOUT_FILENO);
+
+    fix->layers[0]->triggerMapping();
+    unsigned long mapMicros = doMapping();
+    unsigned long start = micros();
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) renderFrame();
+    unsigned long elapsed = max(micros() - start, 1UL);
+
+    fflush(stdout);
+    dup2(savedStdout, STDOUT_FILENO);
+    close(savedStdout);
+    close(devNull);
+
+    TEST_ASSERT_EQUAL(0, fix->mappingStatus);
+    printf("log;%d;%d;%lu;%lu\n", STARBASE_LOG_LEVEL, level, mapMicros, elapsed / BENCHMARK_FRAMES);
+  }
+
+  memcpy(print->logLevels, savedLogLevels, sizeof(savedLogLevels));
+  mdl->setValue("Print", "output", savedOutput);
+  fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+  setupModules();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_fixtures_generated);
+  RUN_TEST(test_starjson_benchmark);
+  RUN_TEST(test_render_benchmark);
+  RUN_TEST(test_blend_benchmark);
+  RUN_TEST(test_log_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,139 @@
+/*
+   @title     StarLight
+   @file      test_ddp.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// DDP packets over host loopback UDP: pio test -e native -f test_ddp -v
+// a receiver reassembles the frame from the packet offsets and checks the header of each packet
+
+#include <unity.h>
+
+#include "Sys/SysModUI.h" //ui and the model, used by the modules
+#include "Sys/SysModInstances.h" //net, sys and mdls
+#include "App/LedModEffects.h"
+#include "App/LedModFixture.h"
+#include "User/UserModDDP.h"
+#include "../native/Loopback.h"
+
+static CRGB leds[TEST_NR_OF_LEDS];
+static uint8_t lut[3][256];
+static uint8_t packet[DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET];
+static uint8_t frame[TEST_NR_OF_LEDS * sizeof(CRGB)];
+
+static int sender = -1;
+static int receiver = -1;
+static sockaddr_in receiverAddress;
+
+void setUp() {
+  fillTestLeds(leds, TEST_NR_OF_LEDS);
+}
+
+void tearDown() {}
+
+static const size_t packetCount = (TEST_NR_OF_LEDS * sizeof(CRGB) + DDP_CHANNELS_PER_PACKET - 1) / DDP_CHANNELS_PER_PACKET;
+
+static size_t sendFrame(uint8_t sequenceNumber) {
+  for (size_t packetNr = 0; packetNr < packetCount; packetNr++) {
+    size_t packetLength = ddpPacket(packet, leds, TEST_NR_OF_LEDS, packetNr, sequenceNumber, lut);
+    sequenceNumber = sequenceNumber % 15 + 1;
+    loopbackSend(sender, receiverAddress, packet, packetLength);
+  }
+  return packetCount;
+}
+
+//receive until the push packet, check each header and copy the data to frame at its offset, returns nr of packets
+static size_t receiveFrame() {
+  uint8_t received[1500];
+  size_t packets = 0;
+  bool push = false;
+  while (!push) {
+    ssize_t len = recv(receiver, received, sizeof(received), 0);
+    TEST_ASSERT_GREATER_THAN(DDP_HEADER_LEN, len);
+
+    TEST_ASSERT_EQUAL_HEX8(DDP_FLAGS1_VER1, received[0] & DDP_FLAGS1_VER);
+    TEST_ASSERT_NOT_EQUAL(0, received[1] & 0x0F); //0 is sequence not used
+    TEST_ASSERT_EQUAL_HEX8(DDP_TYPE_RGB24, received[2]);
+    TEST_ASSERT_EQUAL_HEX8(DDP_ID_DISPLAY, received[3]);
+
+    uint32_t offset = (received[4] << 24) | (received[5] << 16) | (received[6] << 8) | received[7];
+    uint16_t dataLength = (received[8] << 8) | received[9];
+    TEST_ASSERT_EQUAL(len - DDP_HEADER_LEN, dataLength);
+    TEST_ASSERT_LESS_OR_EQUAL(DDP_CHANNELS_PER_PACKET, dataLength);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(frame), offset + dataLength);
+
+    memcpy(frame + offset, received + DDP_HEADER_LEN, dataLength);
+
+    push = received[0] & DDP_FLAGS1_PUSH;
+    //only the packet with the last channels pushes
+    TEST_ASSERT_EQUAL(offset + dataLength == sizeof(frame), push);
+    packets++;
+  }
+  return packets;
+}
+
+//6000 channels: 4 full packets and one of 240
+void test_ddp_layout() {
+  fillTestLut(lut);
+  memset(frame, 0, sizeof(frame));
+
+  size_t sent = sendFrame(1);
+  TEST_ASSERT_EQUAL(5, sent);
+  TEST_ASSERT_EQUAL(sent, receiveFrame());
+  TEST_ASSERT_EQUAL_MEMORY(&leds[0].r, frame, sizeof(frame));
+}
+
+//a different lut per channel: gamma and brightness
+void test_ddp_brightness() {
+  for (int i = 0; i < 256; i++) {
+    lut[0][i] = scale8(i, 128);
+    lut[1][i] = scale8(i, 64);
+    lut[2][i] = 255 - i;
+  }
+
+  sendFrame(1);
+  receiveFrame();
+  for (int i = 0; i < TEST_NR_OF_LEDS; i++) {
+    TEST_ASSERT_EQUAL(scale8(leds[i].r, 128), frame[i * 3]);
+    TEST_ASSERT_EQUAL(scale8(leds[i].g, 64), frame[i * 3 + 1]);
+    TEST_ASSERT_EQUAL(255 - leds[i].b, frame[i * 3 + 2]);
+  }
+}
+
+//packet building only, then including loopback send and receive
+void test_ddp_throughput() {
+  fillTestLut(lut, 200);
+
+  frameThroughput("ddp", "build", [](int frameNr, size_t &bytes) {
+    for (size_t packetNr = 0; packetNr < packetCount; packetNr++)
+      bytes += ddpPacket(packet, leds, TEST_NR_OF_LEDS, packetNr, 1, lut);
+    return packetCount;
+  });
+
+  size_t packets = frameThroughput("ddp", "loopback", [](int frameNr, size_t &bytes) {
+    sendFrame(frameNr % 15 + 1);
+    bytes += sizeof(frame);
+    return receiveFrame();
+  });
+  TEST_ASSERT_EQUAL(TEST_FRAMES * packetCount, packets);
+}
+
+int main(int argc, char **argv) {
+  receiver = loopbackReceiver(receiverAddress);
+  sender = socket(AF_INET, SOCK_DGRAM, 0);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_ddp_layout);
+  RUN_TEST(test_ddp_brightness);
+  RUN_TEST(test_ddp_throughput);
+  int result = UNITY_END();
+
+  close(sender);
+  close(receiver);
+  return result;
+}
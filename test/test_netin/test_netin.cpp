@@ -0,0 +1,196 @@
+/*
+   @title     StarLight
+   @file      test_netin.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// E1.31, Art-Net and DDP pixel input over host loopback UDP: pio test -e native -f test_netin -v
+// packets are send as the DDP and Art-Net outputs send them, received as the AsyncUDP task would and drained into leds as UserModNetIn::loop does
+
+#include <unity.h>
+
+#include "Sys/SysModUI.h" //ui and the model, used by the modules
+#include "Sys/SysModInstances.h" //net, sys and mdls
+#include "App/LedModEffects.h"
+#include "App/LedModFixture.h"
+#include "User/UserModDDP.h" //ddpPacket
+#include "User/UserModArtNet.h" //artnetAddOutput, artnetData
+#include "User/UserModNetIn.h"
+#include "../native/Loopback.h"
+
+static CRGB leds[TEST_NR_OF_LEDS]; //send
+static CRGB received[TEST_NR_OF_LEDS];
+static uint8_t lut[3][256];
+
+static UserModNetIn netIn;
+
+static int sender = -1;
+static int receivers[np_count];
+static sockaddr_in receiverAddresses[np_count];
+
+void setUp() {
+  fillTestLeds(leds, TEST_NR_OF_LEDS);
+  fillTestLut(lut);
+  memset(received, 0, sizeof(received));
+}
+
+void tearDown() {}
+
+//an E1.31 data packet with channels from data, returns the length of the packet
+static size_t e131Packet(uint8_t *packet, uint16_t universe, uint8_t sequence, const uint8_t *data, uint16_t channels) {
+  memset(packet, 0, NETIN_E131_HEADER_SIZE);
+  packet[1] = 0x10; //preamble size
+  memcpy(packet + 4, "ASC-E1.17", 9);
+  packet[21] = 0x04; //root vector E131_DATA
+  packet[43] = 0x02; //framing vector DATA_PACKET
+  packet[108] = 100; //priority
+  packet[111] = sequence;
+  packet[113] = universe >> 8;
+  packet[114] = universe;
+  packet[117] = 0x02; //dmp vector SET_PROPERTY
+  packet[118] = 0xA1; //address and data type
+  packet[122] = 1; //address increment
+  packet[123] = (channels + 1) >> 8; //including the start code
+  packet[124] = channels + 1;
+  memcpy(packet + NETIN_E131_HEADER_SIZE, data, channels);
+  return NETIN_E131_HEADER_SIZE + channels;
+}
+
+static void sendTo(uint8_t protocol, const uint8_t *packet, size_t length) {
+  loopbackSend(sender, receiverAddresses[protocol], packet, length);
+}
+
+//a frame of leds, DDP or in 510 channel universes from universe 1 on, sequenceNumber: per frame for E1.31 and Art-Net, returns the nr of packets
+static size_t sendFrame(uint8_t protocol, uint8_t sequenceNumber) {
+  uint8_t packet[NETIN_PACKET_SIZE];
+  size_t packetCount = 0;
+  if (protocol == np_ddp) {
+    static uint8_t ddpSequence = 0; //per packet
+    for (size_t channel = 0; channel < sizeof(leds); channel += DDP_CHANNELS_PER_PACKET) {
+      ddpSequence = ddpSequence % 15 + 1;
+      sendTo(protocol, packet, ddpPacket(packet, leds, TEST_NR_OF_LEDS, packetCount++, ddpSequence, lut));
+    }
+  } else {
+    std::vector<ArtNetUniverse> universes;
+    artnetAddOutput(universes, 0, TEST_NR_OF_LEDS, 1, 11, false);
+    for (const ArtNetUniverse &universe: universes) {
+      if (protocol == np_artnet) {
+        artnetHeader(packet, universe);
+        sendTo(protocol, packet, artnetData(packet, leds, sizeof(leds), universe, sequenceNumber % 255 + 1, lut));
+      } else
+        sendTo(protocol, packet, e131Packet(packet, universe.portAddress, sequenceNumber, &leds[0].r + universe.channel, universe.channels));
+      packetCount++;
+    }
+  }
+  return packetCount;
+}
+
+static void drain() {
+  while (const NetInQueue::Slot *slot = netIn.queue.front()) {
+    netIn.receive(*slot, received, sizeof(received));
+    netIn.queue.pop();
+  }
+}
+
+//as the AsyncUDP task: push each received packet in the queue, as loop: drain the queue when it is full, returns nr of packets
+static size_t receiveFrame(uint8_t protocol) {
+  uint8_t packet[1500];
+  size_t packetCount = 0;
+  ssize_t len;
+  while ((len = recv(receivers[protocol], packet, sizeof(packet), MSG_DONTWAIT)) > 0) {
+    TEST_ASSERT_TRUE(netIn.queue.push(protocol, packet, len, micros()));
+    if (++packetCount % NETIN_QUEUE_SIZE == 0) drain();
+  }
+  drain();
+  return packetCount;
+}
+
+void test_netin_frame() {
+  static const char * protocolNames[] = {"E1.31", "Art-Net", "DDP"};
+  for (uint8_t protocol = 0; protocol < np_count; protocol++) {
+    memset(received, 0, sizeof(received));
+    size_t sent = sendFrame(protocol, 0);
+    TEST_ASSERT_EQUAL_MESSAGE(sent, receiveFrame(protocol), protocolNames[protocol]);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(leds, received, sizeof(leds), protocolNames[protocol]);
+  }
+}
+
+//universes not mapped are ignored, a universe is only written in its own leds
+void test_netin_universes() {
+  uint8_t packet[NETIN_PACKET_SIZE];
+  uint8_t data[512];
+  memset(data, 0xAA, sizeof(data));
+
+  sendTo(np_e131, packet, e131Packet(packet, 100, 1, data, sizeof(data))); //not mapped
+  sendTo(np_e131, packet, e131Packet(packet, 2, 1, data, sizeof(data))); //leds 170..339, 2 channels too many
+  receiveFrame(np_e131);
+
+  TEST_ASSERT_EQUAL(0, received[169].b);
+  TEST_ASSERT_EQUAL(0xAA, received[170].r);
+  TEST_ASSERT_EQUAL(0xAA, received[339].b);
+  TEST_ASSERT_EQUAL(0, received[340].r);
+}
+
+//missing and out of order packets per protocol
+void test_netin_sequence() {
+  uint16_t last = UINT16_MAX;
+  TEST_ASSERT_EQUAL(0, netInSequence(last, 10, np_e131));
+  TEST_ASSERT_EQUAL(0, netInSequence(last, 11, np_e131));
+  TEST_ASSERT_EQUAL(3, netInSequence(last, 15, np_e131));
+  TEST_ASSERT_EQUAL(-1, netInSequence(last, 14, np_e131)); //out of order
+  TEST_ASSERT_EQUAL(-1, netInSequence(last, 15, np_e131)); //duplicate
+  last = 255;
+  TEST_ASSERT_EQUAL(0, netInSequence(last, 0, np_e131)); //E1.31 wraps to 0
+
+  last = UINT16_MAX;
+  TEST_ASSERT_EQUAL(0, netInSequence(last, 255, np_artnet));
+  TEST_ASSERT_EQUAL(0, netInSequence(last, 1, np_artnet)); //Art-Net wraps to 1
+  TEST_ASSERT_EQUAL(0, netInSequence(last, 0, np_artnet)); //not used
+
+  last = UINT16_MAX;
+  TEST_ASSERT_EQUAL(0, netInSequence(last, 14, np_ddp));
+  TEST_ASSERT_EQUAL(1, netInSequence(last, 1, np_ddp)); //15 missing, DDP wraps to 1
+}
+
+//loopback send, receive, queue and decode
+void test_netin_throughput() {
+  static const char * protocolNames[] = {"e131", "artnet", "ddp"};
+  for (uint8_t protocol = 0; protocol < np_count; protocol++) {
+    frameThroughput("netin", protocolNames[protocol], [protocol](int frameNr, size_t &bytes) {
+      sendFrame(protocol, frameNr);
+      bytes += sizeof(leds);
+      return receiveFrame(protocol);
+    });
+    TEST_ASSERT_EQUAL_MEMORY(leds, received, sizeof(leds));
+  }
+  TEST_ASSERT_EQUAL(0, netIn.queue.dropped);
+}
+
+int main(int argc, char **argv) {
+  sender = socket(AF_INET, SOCK_DGRAM, 0);
+  for (uint8_t protocol = 0; protocol < np_count; protocol++)
+    receivers[protocol] = loopbackReceiver(receiverAddresses[protocol]);
+
+  //leds 0..1999 from universe 1 on, as send by sendFrame
+  netIn.inputUniverse = {1};
+  netIn.inputStart = {0};
+  netIn.inputSize = {TEST_NR_OF_LEDS};
+  netIn.makeUniverses();
+  netIn.queue.reset();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_netin_frame);
+  RUN_TEST(test_netin_universes);
+  RUN_TEST(test_netin_sequence);
+  RUN_TEST(test_netin_throughput);
+  int result = UNITY_END();
+
+  close(sender);
+  for (int receiver: receivers) close(receiver);
+  return result;
+}
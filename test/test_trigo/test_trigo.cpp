@@ -0,0 +1,122 @@
+/*
+   @title     StarLight
+   @file      test_trigo.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+// Fixed point trigonometry: pio test -e native -f test_trigo -v
+// checks the error bounds of sinQ15, cosQ15, atan2Angle and hypotInt against libm and reports cycles per call of both
+// host cycles are derived from micros: compare the functions with each other, not with esp32 timings
+
+#include <unity.h>
+
+#include "App/LedLayer.h" //Trigo and the Q15 functions
+
+#define TEST_CALLS (1 << 20)
+
+void setUp() {}
+
+void tearDown() {}
+
+static int binaryAngle(double radians) {
+  return lround(radians * 65536 / M_TWOPI);
+}
+
+//all angles: error <= 1 in Q15
+void test_trigo_sin_cos() {
+  int maxError = 0;
+  for (int angle = 0; angle < 65536; angle++) {
+    maxError = max(maxError, abs(sinQ15(angle) - (int)lround(32767 * sin(angle * M_TWOPI / 65536))));
+    maxError = max(maxError, abs(cosQ15(angle) - (int)lround(32767 * cos(angle * M_TWOPI / 65536))));
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(1, maxError);
+
+  TEST_ASSERT_EQUAL(0, sinQ15(0));
+  TEST_ASSERT_EQUAL(32767, sinQ15(0x4000));
+  TEST_ASSERT_EQUAL(-32767, sinQ15(0xC000));
+  TEST_ASSERT_EQUAL(-32767, cosQ15(0x8000));
+}
+
+//all directions of a 601 x 601 grid: error <= 17 (0.1°)
+void test_trigo_atan2() {
+  int maxError = 0;
+  for (int y = -300; y <= 300; y++)
+    for (int x = -300; x <= 300; x++) {
+      if (x == 0 && y == 0) continue;
+      int16_t error = atan2Angle(y, x) - (uint16_t)binaryAngle(atan2(y, x)); //wraps around at 0
+      maxError = max(maxError, abs(error));
+    }
+  TEST_ASSERT_LESS_OR_EQUAL(17, maxError);
+
+  TEST_ASSERT_EQUAL(0, atan2Angle(0, 0));
+  TEST_ASSERT_EQUAL(0x4000, atan2Angle(5, 0));
+  TEST_ASSERT_EQUAL(0x8000, atan2Angle(0, -5));
+  TEST_ASSERT_EQUAL(0xE000, atan2Angle(-7, 7));
+}
+
+//exact: rounded down
+void test_trigo_hypot() {
+  for (int y = -2000; y <= 2000; y += 3)
+    for (int x = -2000; x <= 2000; x += 7)
+      TEST_ASSERT_EQUAL((uint32_t)floor(sqrt((double)x * x + (double)y * y)), hypotInt(x, y));
+  TEST_ASSERT_EQUAL(46339, hypotInt(32767, -32767));
+}
+
+//rotations of TiltPanRoll and the fixture generators, float and STARLIGHT_TRIGO_Q15
+void test_trigo_rotate() {
+  Trigo trigo(360);
+  TEST_ASSERT_EQUAL(100, trigo.sin(100, 90));
+  TEST_ASSERT_EQUAL(-100, trigo.cos(100, 180));
+  TEST_ASSERT_INT_WITHIN(1, 70, trigo.sin(100, 45)); //70.7: truncated as float, rounded with STARLIGHT_TRIGO_Q15
+  Coord3D pixel = trigo.roll({20, 10, 0}, {10, 10, 0}, 90);
+  TEST_ASSERT_EQUAL(10, pixel.x);
+  TEST_ASSERT_EQUAL(20, pixel.y);
+
+  Trigo16 trigo16(360); //sin16 peaks at 32645: full scale as float
+  TEST_ASSERT_EQUAL(1000, trigo16.sin(1000, 90));
+  TEST_ASSERT_EQUAL(-1000, trigo16.cos(1000, 180));
+}
+
+//volatile: the compiler may not remove or hoist the calls
+template <typename Function>
+static float cyclesPerCall(Function function) {
+  uint32_t cycles = ESP.getCycleCount();
+  for (int i = 0; i < TEST_CALLS; i++) function(i);
+  return float(ESP.getCycleCount() - cycles) / TEST_CALLS;
+}
+
+void test_trigo_benchmark() {
+  volatile int32_t sinkInt = 0;
+  volatile float sinkFloat = 0;
+
+  printf("trigo;function;cycles/call;libm cycles/call\n");
+
+  float fixed = cyclesPerCall([&](int i) {sinkInt = sinkInt + sinQ15(i * 7);});
+  float libm = cyclesPerCall([&](int i) {sinkFloat = sinkFloat + sinf(i * 7 / ANGLE_PER_RADIAN);});
+  printf("trigo;sin;%.1f;%.1f\n", fixed, libm);
+
+  fixed = cyclesPerCall([&](int i) {sinkInt = sinkInt + atan2Angle((i & 1023) - 512, (i >> 10) - 512);});
+  libm = cyclesPerCall([&](int i) {sinkFloat = sinkFloat + atan2f((i & 1023) - 512, (i >> 10) - 512);});
+  printf("trigo;atan2;%.1f;%.1f\n", fixed, libm);
+
+  fixed = cyclesPerCall([&](int i) {sinkInt = sinkInt + hypotInt((i & 1023) - 512, (i >> 10) - 512);});
+  libm = cyclesPerCall([&](int i) {sinkFloat = sinkFloat + hypotf((i & 1023) - 512, (i >> 10) - 512);});
+  printf("trigo;hypot;%.1f;%.1f\n", fixed, libm);
+
+  fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_trigo_sin_cos);
+  RUN_TEST(test_trigo_atan2);
+  RUN_TEST(test_trigo_hypot);
+  RUN_TEST(test_trigo_rotate);
+  RUN_TEST(test_trigo_benchmark);
+  return UNITY_END();
+}